@@ -27,16 +27,30 @@ DEALINGS IN THE SOFTWARE.
 #ifndef JETSON_GPIO_H
 #define JETSON_GPIO_H
 
+#include <cstdint>
 #include <initializer_list>
 #include <string>
 #include <vector>
 
 #include "JetsonGPIO/Callback.h"
+#include "JetsonGPIO/CallbackStats.h"
+#include "JetsonGPIO/EdgeEvent.h"
+#include "JetsonGPIO/EventBufferStats.h"
+#include "JetsonGPIO/EventStats.h"
+#include "JetsonGPIO/InputGroup.h"
 #include "JetsonGPIO/LazyString.h"
+#include "JetsonGPIO/OutputStats.h"
 #include "JetsonGPIO/PWM.h"
+#include "JetsonGPIO/Pin.h"
+#include "JetsonGPIO/PinGroup.h"
 #include "JetsonGPIO/PublicEnums.h"
+#include "JetsonGPIO/PulseCapture.h"
+#include "JetsonGPIO/PulseCount.h"
+#include "JetsonGPIO/QuadratureEncoder.h"
+#include "JetsonGPIO/SoftPWM.h"
 #include "JetsonGPIO/TypeTraits.h"
 #include "JetsonGPIO/WaitResult.h"
+#include "JetsonGPIO/WaveformPlayer.h"
 #include "JetsonGPIOConfig.h"
 
 namespace GPIO
@@ -48,6 +62,7 @@ namespace GPIO
 
     constexpr int HIGH = 1;
     constexpr int LOW = 0;
+    constexpr int TOGGLE = 2; // value of add_reflex()
 
     // Function used to enable/disable warnings during setup and cleanup.
     void setwarnings(bool state);
@@ -59,6 +74,15 @@ namespace GPIO
     // Function used to get the currently set pin numbering mode
     NumberingModes getmode();
 
+    /* Function used to select the kernel interface used to access the GPIO lines.
+       Must be called before setmode(). The default is SYSFS, or the value of the
+       JETSON_GPIO_BACKEND environment variable ("sysfs" or "cdev") if it is set.
+       @backend must be SYSFS or CDEV */
+    void setbackend(Backends backend);
+
+    // Function used to get the kernel interface used to access the GPIO lines
+    Backends getbackend();
+
     /* Function used to setup individual pins as Input or Output.
        @direction must be IN or OUT
        @initial must be HIGH, LOW or -1 and is only valid when direction is OUT  */
@@ -85,6 +109,13 @@ namespace GPIO
     int input(const std::string& channel);
     int input(int channel);
 
+    /* Function used to read up to 64 channels at once. The channels are sampled as close together
+       in time as the backend allows (see GPIO::InputGroup for repeated reads of the same channels).
+       @returns bit i is HIGH if the i-th channel is HIGH (std::bitset<64> can be built from it) */
+    uint64_t input(const std::vector<std::string>& channels);
+    uint64_t input(const std::vector<int>& channels);
+    uint64_t input(const std::initializer_list<int>& channels);
+
     /* Function used to set a value to a channel.
        @value must be either HIGH or LOW */
     void output(const std::string& channel, int value);
@@ -96,6 +127,23 @@ namespace GPIO
     void output(const std::initializer_list<int>& channels, const std::vector<int>& values);
     void output(const std::vector<int>& channels, const std::vector<int>& values);
 
+    /* Function used to invert the value of a channel set up as OUT.
+       The last value written is used if it is known, otherwise the value is read back first. */
+    void toggle(const std::string& channel);
+    void toggle(int channel);
+
+    /* Function used to enable/disable the output cache (disabled by default).
+       While it is enabled, writing the value that a channel set up as OUT already has is skipped,
+       so only use it if nothing else changes the lines. */
+    void setoutputcache(bool state);
+
+    /* Function used to get the number of writes to output channels and how many of them the output cache skipped.
+       If no channel is provided, the totals since the program started are returned.
+       The counters of a channel are reset when it is set up. */
+    OutputStats output_stats();
+    OutputStats output_stats(const std::string& channel);
+    OutputStats output_stats(int channel);
+
     /* Function used to check the currently set function of the channel specified. */
     Directions gpio_function(const std::string& channel);
     Directions gpio_function(int channel);
@@ -128,6 +176,91 @@ namespace GPIO
     void remove_event_detect(const std::string& channel);
     void remove_event_detect(int channel);
 
+    /* Function used to reject the glitches of a channel registered with add_event_detect(): after an edge, the
+       level is sampled again when the window has passed, and the event is delivered (with that level) only if the
+       channel held it with no other edge in between. The events are delayed by the window.
+       Unlike the bounce time, it doesn't drop fast edges that are stable. The rejected edges are counted in
+       event_stats(). Only the events of add_event_detect() are filtered, not wait_for_edge().
+       @window_us is the window in microseconds (0 removes the filter) */
+    void set_glitch_filter(const std::string& channel, unsigned long window_us);
+    void set_glitch_filter(int channel, unsigned long window_us);
+
+    /* Function used to write an output from the event thread when a channel registered with add_event_detect()
+       detects an edge, e.g. for safety interlocks. The output is written right after the detection (after the
+       bounce time and the glitch filter), before the events are buffered and the callbacks are called, with no
+       channel lookup. The reaction latencies and the failed writes are counted in event_stats().
+       The reflexes are removed by remove_event_detect(), remove_reflexes() or the cleanup of the output.
+       @input_channel is an integer or a string specifying the channel with event detection
+       @edge must be RISING, FALLING or BOTH
+       @output_channel must have been set up as an OUTPUT. output() and toggle() don't skip its writes anymore.
+       @value must be HIGH, LOW or TOGGLE */
+    void add_reflex(const std::string& input_channel, Edge edge, const std::string& output_channel, int value);
+    void add_reflex(int input_channel, Edge edge, int output_channel, int value);
+
+    /* Function used to remove the reflexes of a channel added with add_reflex() */
+    void remove_reflexes(const std::string& channel);
+    void remove_reflexes(int channel);
+
+    /* Function used to keep the edges of a channel registered with add_event_detect() in a buffer, so that all of
+       them can be read with read_events() instead of only checking event_detected().
+       @size is the number of events kept (0 removes the buffer). The events detected while it is full are dropped. */
+    void set_event_buffer(const std::string& channel, size_t size);
+    void set_event_buffer(int channel, size_t size);
+
+    /* Function used to take the oldest events out of the event buffer of a channel, without waiting.
+       Must not be called for one channel by several threads at once.
+       @events is an array of at least max events
+       @returns the number of events written to events */
+    size_t read_events(const std::string& channel, EdgeEvent* events, size_t max);
+    size_t read_events(int channel, EdgeEvent* events, size_t max);
+
+    /* Function used to get the size, the number of waiting events and the number of dropped events of the event
+       buffer of a channel. */
+    EventBufferStats event_buffer_stats(const std::string& channel);
+    EventBufferStats event_buffer_stats(int channel);
+
+    /* Function used to count the edges of a channel instead of detecting events, e.g. for flow meters and fan
+       tachometers. The event thread only counts the edges and records their time: no callbacks, no event_detected().
+       Use remove_event_detect() to stop counting.
+       @channel is an integer or a string specifying the channel
+       @edge must be a member of GPIO::Edge */
+    void add_pulse_counter(const std::string& channel, Edge edge);
+    void add_pulse_counter(int channel, Edge edge);
+
+    /* Function used to get the count and the frequency of the pulses of a channel set with add_pulse_counter().
+       It doesn't wait for the event thread. */
+    PulseCount pulse_count(const std::string& channel);
+    PulseCount pulse_count(int channel);
+
+    /* Function used to set the number of threads that call the event callbacks (default=1).
+       The callbacks of a channel are called by one thread at a time, in the order of the events,
+       so more workers only help when callbacks of different channels are slow. */
+    void setcallbackworkers(unsigned workers);
+
+    /* Function used to set how many detected events can wait for a callback worker (default=1024).
+       The callbacks of the events detected while the queue is full are not called. */
+    void setcallbackqueuesize(size_t size);
+
+    /* Function used to get the number of events waiting for a callback worker and the number of events
+       dispatched and dropped since the program started. */
+    CallbackStats callback_stats();
+
+    /* Function used to get the counters of the event detection: for each channel, the edges read, the edges
+       dropped by the bounce time and the durations of the callbacks. It doesn't wait for the event thread. */
+    EventStats event_stats();
+
+    /* Function used to run the event detection in the application's own event loop (epoll, libuv, asio...)
+       instead of the event thread. Returns a file descriptor that becomes readable when there are edges or
+       changes to handle: call process_events() then. No event thread is started from the first call on,
+       which must come before any event detection. The file descriptor stays open until the program ends. */
+    int event_fd();
+
+    /* Function used to handle the edges and the changes (add_event_detect(), remove_event_detect()...) that are
+       ready, on the calling thread and without waiting. The callbacks are called before it returns.
+       Returns the number of edges handled. event_fd() must be called first, and it must not be called by several
+       threads at once. */
+    int process_events();
+
     /* Function used to perform a blocking wait until the specified edge event is detected within the specified
        timeout period. Returns the channel if an event is detected or 0 if a timeout has occurred.
        @channel is an integer or a string specifying the channel
@@ -139,6 +272,18 @@ namespace GPIO
                              unsigned long timeout = 0);
     WaitResult wait_for_edge(int channel, Edge edge, unsigned long bounce_time = 0, unsigned long timeout = 0);
 
+    /* Function used to perform a blocking wait until the specified edge event is detected on any of the specified
+       channels within the specified timeout period. All the channels are waited for by the calling thread.
+       @channels is a vector of integers or strings specifying the channels
+       @edge must be a member of GPIO::Edge
+       @bouncetime in milliseconds (optional)
+       @timeout in milliseconds (optional)
+       @returns the first edge of each channel that fired, or an empty vector if a timeout has occurred */
+    std::vector<EdgeEvent> wait_for_edges(const std::vector<std::string>& channels, Edge edge,
+                                          unsigned long bounce_time = 0, unsigned long timeout = 0);
+    std::vector<EdgeEvent> wait_for_edges(const std::vector<int>& channels, Edge edge, unsigned long bounce_time = 0,
+                                          unsigned long timeout = 0);
+
 } // namespace GPIO
 
 #endif // JETSON_GPIO_H
@@ -24,9 +24,13 @@ DEALINGS IN THE SOFTWARE.
 #ifndef CALLBACK_H
 #define CALLBACK_H
 
+#include "JetsonGPIO/EdgeEvent.h"
 #include "JetsonGPIO/TypeTraits.h"
-#include <functional>
+#include <cstddef>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace GPIO
 {
@@ -37,130 +41,211 @@ namespace GPIO
 
     namespace details
     {
-        class NoArgCallback;
-
         // type traits
         enum class CallbackType
         {
+            Event,
             Normal,
             NoArg
         };
 
-        template <CallbackType e> struct CallbackConstructorOverload
+        template <class T, class = void> struct is_event_callable : std::false_type
+        {
+        };
+
+        template <class T>
+        struct is_event_callable<T, std::void_t<decltype(std::declval<T&>()(std::declval<const EdgeEvent&>()))>>
+        : std::true_type
+        {
+        };
+
+        template <class T, class = void> struct is_string_callable : std::false_type
         {
         };
 
         template <class T>
-        constexpr bool is_no_argument_callback =
-            !std::is_same<std::decay_t<T>, NoArgCallback>::value && std::is_constructible<NoArgCallback, T&&>::value;
+        struct is_string_callable<T, std::void_t<decltype(std::declval<T&>()(std::declval<const std::string&>()))>>
+        : std::true_type
+        {
+        };
+
+        template <class T, class = void> struct is_no_argument_callable : std::false_type
+        {
+        };
 
         template <class T>
-        constexpr bool is_string_argument_callback =
-            std::is_constructible<std::function<void(const std::string&)>, T&&>::value;
+        struct is_no_argument_callable<T, std::void_t<decltype(std::declval<T&>()())>> : std::true_type
+        {
+        };
+
+        template <class T> constexpr bool is_event_argument_callback = is_event_callable<T>::value;
+        template <class T> constexpr bool is_string_argument_callback = is_string_callable<T>::value;
+        template <class T> constexpr bool is_no_argument_callback = is_no_argument_callable<T>::value;
 
         template <class T> constexpr CallbackType CallbackTypeSelector()
         {
-            static_assert(std::is_copy_constructible<std::decay_t<T>>::value, "Callback must be copy-constructible");
+            static_assert(std::is_copy_constructible<T>::value, "Callback must be copy-constructible");
 
-            static_assert(is_no_argument_callback<T> || is_string_argument_callback<T>, "Callback must be callable");
+            static_assert(is_no_argument_callback<T> || is_string_argument_callback<T> || is_event_argument_callback<T>,
+                          "Callback must be callable");
 
             static_assert(details::is_equality_comparable_v<const T&>,
                           "Callback function MUST be equality comparable. ex> f0 == f1");
 
-            return is_string_argument_callback<T> ? CallbackType::Normal : CallbackType::NoArg;
+            return is_event_argument_callback<T>    ? CallbackType::Event
+                   : is_string_argument_callback<T> ? CallbackType::Normal
+                                                    : CallbackType::NoArg;
         }
 
-        template <class arg_t> struct CallbackCompare
+        /* Callables up to this size that can be moved without throwing are stored in the Callback itself,
+           so a lambda with a few captures or a function pointer never allocates. Larger ones are on the heap. */
+        constexpr size_t callback_buffer_size = 4 * sizeof(void*);
+
+        template <class T>
+        constexpr bool is_stored_inline = sizeof(T) <= callback_buffer_size &&
+                                          alignof(T) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible<T>::value;
+
+        template <class T, bool = is_stored_inline<T>> struct CallbackStorage
         {
-            using func_t = std::function<arg_t>;
+            static T* get(void* buffer) { return static_cast<T*>(buffer); }
+            static const T* get(const void* buffer) { return static_cast<const T*>(buffer); }
 
-            template <class T> static bool Compare(const func_t& A, const func_t& B)
+            template <class U> static void create(void* buffer, U&& value) { new (buffer) T(std::forward<U>(value)); }
+            static void copy(void* dst, const void* src) { new (dst) T(*get(src)); }
+            static void move(void* dst, void* src)
             {
-                if (A == nullptr && B == nullptr)
-                    return true;
+                new (dst) T(std::move(*get(src)));
+                get(src)->~T();
+            }
+            static void destroy(void* buffer) { get(buffer)->~T(); }
+        };
 
-                const T* targetA = A.template target<T>();
-                const T* targetB = B.template target<T>();
+        // the buffer holds a pointer to the callable
+        template <class T> struct CallbackStorage<T, false>
+        {
+            static T* get(void* buffer) { return *static_cast<T**>(buffer); }
+            static const T* get(const void* buffer) { return *static_cast<T* const*>(buffer); }
 
-                return targetA != nullptr && targetB != nullptr && *targetA == *targetB;
+            template <class U> static void create(void* buffer, U&& value)
+            {
+                *static_cast<T**>(buffer) = new T(std::forward<U>(value));
             }
+            static void copy(void* dst, const void* src) { *static_cast<T**>(dst) = new T(*get(src)); }
+            static void move(void* dst, void* src) { *static_cast<T**>(dst) = get(src); }
+            static void destroy(void* buffer) { delete get(buffer); }
         };
 
-        class NoArgCallback
-        {
-        private:
-            using func_t = std::function<void()>;
-            using comparer_impl = details::CallbackCompare<void()>;
+        template <class T, CallbackType type> struct CallbackInvoker;
 
-        public:
-            NoArgCallback(const NoArgCallback&) = default;
-            NoArgCallback(NoArgCallback&&) = default;
+        template <class T> struct CallbackInvoker<T, CallbackType::Event>
+        {
+            static void invoke(void* buffer, const EdgeEvent& event) { (*CallbackStorage<T>::get(buffer))(event); }
+        };
 
-            template <class T, class = std::enable_if_t<!std::is_same<std::decay_t<T>, std::nullptr_t>::value &&
-                                                        std::is_constructible<func_t, T&&>::value>>
-            NoArgCallback(T&& function)
-            : function(std::forward<T>(function)), comparer(comparer_impl::Compare<std::decay_t<T>>)
+        template <class T> struct CallbackInvoker<T, CallbackType::Normal>
+        {
+            static void invoke(void* buffer, const EdgeEvent& event)
             {
+                (*CallbackStorage<T>::get(buffer))(event.channel);
             }
+        };
 
-            NoArgCallback& operator=(const NoArgCallback&) = default;
-            NoArgCallback& operator=(NoArgCallback&&) = default;
-
-            bool operator==(const NoArgCallback& other) const { return comparer(function, other.function); }
-            bool operator!=(const NoArgCallback& other) const { return !(*this == other); }
+        template <class T> struct CallbackInvoker<T, CallbackType::NoArg>
+        {
+            static void invoke(void* buffer, const EdgeEvent&) { (*CallbackStorage<T>::get(buffer))(); }
+        };
 
-            void operator()(const std::string&) const { function(); }
+        /* The operations on the callable stored in a Callback. There is one table per callable type,
+           so two callbacks store the same type if they point to the same table. */
+        struct CallbackOps
+        {
+            void (*invoke)(void* buffer, const EdgeEvent& event);
+            void (*copy)(void* dst, const void* src);
+            void (*move)(void* dst, void* src); // src is left without a callable
+            void (*destroy)(void* buffer);
+            bool (*equal)(const void* A, const void* B);
 
-        private:
-            func_t function;
-            std::function<bool(const func_t&, const func_t&)> comparer;
+            template <class T, CallbackType type> static const CallbackOps* of()
+            {
+                static const CallbackOps ops = {CallbackInvoker<T, type>::invoke, CallbackStorage<T>::copy,
+                                                CallbackStorage<T>::move, CallbackStorage<T>::destroy,
+                                                [](const void* A, const void* B)
+                                                { return *CallbackStorage<T>::get(A) == *CallbackStorage<T>::get(B); }};
+                return &ops;
+            }
         };
 
+        // a null function pointer is an empty callback, like std::function
+        template <class T> bool is_null_callable(const T&) { return false; }
+        template <class T> bool is_null_callable(T* function) { return function == nullptr; }
+
+        // a function pointer with a context pointer, see Callback(function_t, void*)
+        struct ContextCallback
+        {
+            void (*function)(const EdgeEvent& event, void* context);
+            void* context;
+
+            void operator()(const EdgeEvent& event) const { function(event, context); }
+            bool operator==(const ContextCallback& other) const
+            {
+                return function == other.function && context == other.context;
+            }
+        };
     } // namespace details
 
+    /* A callback function called when an edge is detected. It is called with an EdgeEvent,
+       the channel name (const std::string&) or without any argument.
+       The callable is stored inline when it is small (function pointers, lambdas with a few captures),
+       and calling it is one indirect call. */
     class Callback
     {
-    private:
-        using func_t = std::function<void(const std::string&)>;
-        using comparer_impl = details::CallbackCompare<void(const std::string&)>;
+    public:
+        using function_t = void (*)(const EdgeEvent& event, void* context);
 
-        template <class T>
-        Callback(T&& function, details::CallbackConstructorOverload<details::CallbackType::Normal>)
-        : function(std::forward<T>(function)), comparer(comparer_impl::Compare<std::decay_t<T>>)
-        {
-            static_assert(std::is_constructible<func_t, T&&>::value,
-                          "Callback return type: void, argument type: const std::string&");
-        }
+        Callback(std::nullptr_t = nullptr) noexcept {}
 
-        template <class T>
-        Callback(T&& noArgFunction, details::CallbackConstructorOverload<details::CallbackType::NoArg>)
-        : function(details::NoArgCallback(std::forward<T>(noArgFunction))),
-          comparer(comparer_impl::Compare<details::NoArgCallback>)
+        template <class T, class = std::enable_if_t<!std::is_same<std::decay_t<T>, Callback>::value &&
+                                                    !std::is_same<std::decay_t<T>, std::nullptr_t>::value>>
+        Callback(T&& function)
         {
+            using callable_t = std::decay_t<T>;
+            constexpr details::CallbackType type = details::CallbackTypeSelector<callable_t>();
+
+            if (details::is_null_callable(function))
+                return;
+
+            details::CallbackStorage<callable_t>::create(_buffer, std::forward<T>(function));
+            _ops = details::CallbackOps::of<callable_t, type>();
         }
 
-    public:
-        Callback(const Callback&) = default;
-        Callback(Callback&&) = default;
+        // function is called with the event and context. Equal to another callback with the same function and context.
+        Callback(function_t function, void* context);
 
-        template <class T>
-        Callback(T&& function)
-        : Callback(std::forward<T>(function),
-                   details::CallbackConstructorOverload<details::CallbackTypeSelector<T>()>{})
+        Callback(const Callback& other);
+        Callback(Callback&& other) noexcept;
+        ~Callback();
+
+        Callback& operator=(const Callback& other);
+        Callback& operator=(Callback&& other) noexcept;
+
+        void operator()(const EdgeEvent& event) const
         {
+            if (_ops != nullptr)
+                _ops->invoke(_buffer, event);
         }
 
-        Callback& operator=(const Callback&) = default;
-        Callback& operator=(Callback&&) = default;
-
-        void operator()(const std::string& input) const;
+        // call with an event that only has the channel name
+        void operator()(const std::string& channel) const;
 
         friend bool operator==(const Callback& A, const Callback& B);
         friend bool operator!=(const Callback& A, const Callback& B);
 
     private:
-        func_t function;
-        std::function<bool(const func_t&, const func_t&)> comparer;
+        void _reset() noexcept;
+
+        const details::CallbackOps* _ops = nullptr; // nullptr if empty
+        alignas(std::max_align_t) mutable unsigned char _buffer[details::callback_buffer_size];
     };
 
 } // namespace GPIO
@@ -0,0 +1,42 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef CALLBACK_STATS_H
+#define CALLBACK_STATS_H
+
+#include <cstddef>
+
+namespace GPIO
+{
+    // Counters of the queue between the event thread and the callback workers
+    struct CallbackStats
+    {
+        unsigned long long dispatched = 0; // events whose callbacks have been called
+        unsigned long long dropped = 0;    // events discarded because the queue was full
+        size_t queued = 0;                 // events waiting for a worker
+        size_t max_queued = 0;             // the largest number of events that have been waiting at once
+    };
+
+} // namespace GPIO
+
+#endif
@@ -0,0 +1,51 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef EDGE_EVENT_H
+#define EDGE_EVENT_H
+
+#include <cstdint>
+#include <string>
+
+#include "JetsonGPIO/PublicEnums.h"
+
+namespace GPIO
+{
+    // An edge detected on a channel set up with add_event_detect()
+    struct EdgeEvent
+    {
+        std::string channel;
+        Edge edge = Edge::UNKNOWN; // RISING or FALLING
+        int level = -1;            // the value of the channel after the edge (HIGH or LOW), -1 if unknown
+
+        /* CLOCK_MONOTONIC time of the edge in nanoseconds. Recorded by the kernel with the character device
+           backend (GPIO::CDEV), otherwise read as soon as the event thread is woken up by the edge. */
+        uint64_t timestamp_ns = 0;
+
+        // number of the reported edge on the channel since add_event_detect(), starting at 1
+        uint64_t seqno = 0;
+    };
+
+} // namespace GPIO
+
+#endif
@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef EVENT_STATS_H
+#define EVENT_STATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GPIO
+{
+    // Counters of a channel with edge detection, since the detection was added
+    struct ChannelEventStats
+    {
+        std::string channel;
+        unsigned long long edges = 0;     // edges read from the channel
+        unsigned long long debounced = 0; // edges dropped by the bounce time
+        unsigned long long glitches = 0;  // edges rejected by the glitch filter
+        unsigned long long callbacks = 0; // calls of the callbacks of the channel
+
+        /* true if the bounce time is applied by the kernel (character device backend): the bounces are dropped
+           before they reach the event thread and are not counted in edges nor debounced. false if the library
+           filters the edges, or if the channel has no bounce time. */
+        bool kernel_debounce = false;
+
+        // durations of the callback calls. The percentiles are upper bounds (powers of 2, at most the maximum).
+        uint64_t max_callback_ns = 0;
+        uint64_t p50_callback_ns = 0;
+        uint64_t p99_callback_ns = 0;
+
+        /* outputs written by the reflexes of the channel (add_reflex()), and the writes that failed. The reaction
+           latencies are measured from the time of the edge to the end of the write, like the callback durations. */
+        unsigned long long reflexes = 0;
+        unsigned long long reflex_errors = 0;
+        uint64_t max_reflex_ns = 0;
+        uint64_t p50_reflex_ns = 0;
+        uint64_t p99_reflex_ns = 0;
+    };
+
+    // A snapshot of the counters of the event detection (see event_stats())
+    struct EventStats
+    {
+        unsigned long long wakeups = 0;      // passes of the event loop
+        unsigned long long full_batches = 0; // passes that had more ready channels than they could take at once
+        std::vector<ChannelEventStats> channels;
+    };
+
+} // namespace GPIO
+
+#endif
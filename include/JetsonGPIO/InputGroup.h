@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+#ifndef INPUT_GROUP_H
+#define INPUT_GROUP_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GPIO
+{
+    /* A preallocated set of up to 64 channels that have already been set up with GPIO::setup(), sampled together.
+       read() does no lookup and no allocation. Lines of the same gpio chip are requested together and read
+       with one system call when the backend supports it (GPIO::CDEV).
+       The handle becomes invalid when one of the channels is cleaned up. */
+    class InputGroup
+    {
+    public:
+        InputGroup(const std::vector<std::string>& channels);
+        InputGroup(const std::vector<int>& channels);
+        InputGroup(const std::initializer_list<int>& channels);
+        InputGroup(InputGroup&& other);
+        InputGroup& operator=(InputGroup&& other);
+        InputGroup(const InputGroup&) = delete;
+        InputGroup& operator=(const InputGroup&) = delete;
+        ~InputGroup();
+
+        // @returns bit i is HIGH if the i-th channel is HIGH (std::bitset<64> can be built from it)
+        uint64_t read() const;
+
+        size_t size() const;
+        const std::string& channel(size_t i) const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef PIN_H
+#define PIN_H
+
+#include <memory>
+#include <string>
+
+#include "JetsonGPIO/PublicEnums.h"
+
+namespace GPIO
+{
+    /* A handle to a channel that has already been set up with GPIO::setup().
+       The channel lookup and validation that GPIO::output() and GPIO::input() do on every call
+       is done once in the constructor, so write(), read() and toggle() only cost the I/O itself.
+       The handle becomes invalid when the channel is cleaned up. */
+    class Pin
+    {
+    public:
+        Pin(const std::string& channel);
+        Pin(int channel);
+        Pin(Pin&& other);
+        Pin& operator=(Pin&& other);
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        ~Pin();
+
+        // @value must be either HIGH or LOW. The channel must be set up as OUT.
+        void write(int value);
+
+        // @returns either HIGH or LOW
+        int read() const;
+
+        // Same as GPIO::toggle(channel). The channel must be set up as OUT.
+        void toggle();
+
+        const std::string& channel() const;
+        Directions direction() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
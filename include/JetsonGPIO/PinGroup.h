@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+#ifndef PIN_GROUP_H
+#define PIN_GROUP_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GPIO
+{
+    /* A handle to up to 64 channels that have already been set up with GPIO::setup(), accessed as one port.
+       Bit i of the masks and values is the i-th channel of the constructor argument.
+       Lines of the same gpio chip are written and read with one system call when the backend supports it
+       (GPIO::CDEV), so they change at the same time. With GPIO::SYSFS every line is still one write.
+       The handle becomes invalid when one of the channels is cleaned up. */
+    class PinGroup
+    {
+    public:
+        PinGroup(const std::vector<std::string>& channels);
+        PinGroup(const std::vector<int>& channels);
+        PinGroup(const std::initializer_list<int>& channels);
+        PinGroup(PinGroup&& other);
+        PinGroup& operator=(PinGroup&& other);
+        PinGroup(const PinGroup&) = delete;
+        PinGroup& operator=(const PinGroup&) = delete;
+        ~PinGroup();
+
+        /* Set the channels selected by @mask to the matching bits of @values.
+           The selected channels must be set up as OUT. */
+        void write(uint64_t mask, uint64_t values);
+
+        // @returns the values of all channels (HIGH == 1)
+        uint64_t read() const;
+
+        size_t size() const;
+        const std::string& channel(size_t i) const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
@@ -64,6 +64,10 @@ namespace GPIO
     // GPIO Event Types
     PUBLIC_ENUM_CLASS(Edge, UNKNOWN, NONE, RISING, FALLING, BOTH);
 
+    // Kernel interfaces used to access the GPIO lines
+    // SYSFS: /sys/class/gpio (deprecated by the kernel), CDEV: GPIO character device (/dev/gpiochip*, uAPI v2)
+    PUBLIC_ENUM_CLASS(Backends, SYSFS, CDEV);
+
     // alias for GPIO::NumberingModes
     constexpr NumberingModes BOARD = NumberingModes::BOARD;
     constexpr NumberingModes BCM = NumberingModes::BCM;
@@ -83,6 +87,10 @@ namespace GPIO
     constexpr Edge FALLING = Edge::FALLING;
     constexpr Edge BOTH = Edge::BOTH;
 
+    // alias for GPIO::Backends
+    constexpr Backends SYSFS = Backends::SYSFS;
+    constexpr Backends CDEV = Backends::CDEV;
+
 } // namespace GPIO
 
 #undef PUBLIC_ENUM_CLASS
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef PULSE_CAPTURE_H
+#define PULSE_CAPTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace GPIO
+{
+    // One pulse measured by a PulseCapture. The times are CLOCK_MONOTONIC nanoseconds.
+    struct PulseMeasurement
+    {
+        uint64_t rise_ns = 0;   // time of the rising edge
+        uint64_t width_ns = 0;  // from the rising edge to the falling edge
+        uint64_t period_ns = 0; // from the previous rising edge to this one, 0 for the first pulse
+    };
+
+    // Statistics of the pulses measured since the PulseCapture was created
+    struct PulseCaptureStats
+    {
+        unsigned long long pulses = 0; // pulses measured (rising edge followed by a falling edge)
+        uint64_t min_width_ns = 0;
+        uint64_t max_width_ns = 0;
+        double mean_width_ns = 0.0;
+
+        unsigned long long periods = 0; // rising edges measured from the previous one
+        uint64_t min_period_ns = 0;
+        uint64_t max_period_ns = 0;
+        double mean_period_ns = 0.0;
+
+        unsigned long long overflows = 0; // measurements dropped because read() didn't keep up
+    };
+
+    /* Measures the width and the period of the pulses on a channel set up as IN, e.g. RC receivers or ultrasonic
+       sensors. The edges are timestamped and measured in the event thread, without callbacks: the kernel
+       timestamps are used with the character device backend (GPIO::CDEV). The channel can't detect events while
+       it is captured. */
+    class PulseCapture
+    {
+    public:
+        // capacity: the number of measurements kept for read()
+        PulseCapture(const std::string& channel, size_t capacity = 256);
+        PulseCapture(int channel, size_t capacity = 256);
+        PulseCapture(PulseCapture&& other);
+        PulseCapture& operator=(PulseCapture&& other);
+        PulseCapture(const PulseCapture&) = delete;
+        PulseCapture& operator=(const PulseCapture&) = delete;
+        ~PulseCapture(); // stops the capture
+
+        /* Takes the oldest measurements out, without waiting. Must not be called by several threads at once.
+           Returns the number of measurements written to measurements (an array of at least max). */
+        size_t read(PulseMeasurement* measurements, size_t max);
+
+        PulseCaptureStats stats() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
@@ -0,0 +1,46 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef PULSE_COUNT_H
+#define PULSE_COUNT_H
+
+#include <cstdint>
+
+namespace GPIO
+{
+    // The state of a pulse counter (see add_pulse_counter())
+    struct PulseCount
+    {
+        unsigned long long count = 0; // edges counted since add_pulse_counter()
+        uint64_t last_edge_ns = 0;    // CLOCK_MONOTONIC time of the last edge, 0 if there was none
+
+        /* Pulses per second from the interval between the last two edges, and from the moving average of the
+           intervals. Both decrease once the time since the last edge is longer than the interval, so they fall to
+           0 when the pulses stop. 0 until two edges have been counted. */
+        double frequency_hz = 0;
+        double average_frequency_hz = 0;
+    };
+
+} // namespace GPIO
+
+#endif
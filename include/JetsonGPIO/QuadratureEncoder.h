@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef QUADRATURE_ENCODER_H
+#define QUADRATURE_ENCODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace GPIO
+{
+    /* Decodes a quadrature (incremental) encoder on two channels set up as IN: the position counts the 4 edges of
+       every cycle of A and B. The edges are decoded in the event thread, without callbacks, and the position,
+       direction and errors are lock-free reads from any thread. The channels can't detect events while they are
+       decoded. */
+    class QuadratureEncoder
+    {
+    public:
+        QuadratureEncoder(const std::string& channel_a, const std::string& channel_b);
+        QuadratureEncoder(int channel_a, int channel_b);
+        QuadratureEncoder(QuadratureEncoder&& other);
+        QuadratureEncoder& operator=(QuadratureEncoder&& other);
+        QuadratureEncoder(const QuadratureEncoder&) = delete;
+        QuadratureEncoder& operator=(const QuadratureEncoder&) = delete;
+        ~QuadratureEncoder(); // stops the decoding
+
+        // counts since the encoder was created: up when A leads B, down when B leads A
+        int64_t position() const;
+
+        // direction of the last step: 1 (A leads B), -1 (B leads A) or 0 before the first step
+        int direction() const;
+
+        // illegal transitions (an edge that didn't change the levels): steps missed, e.g. the encoder turned too fast
+        unsigned long long errors() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
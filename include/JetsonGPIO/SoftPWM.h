@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef SOFT_PWM_H
+#define SOFT_PWM_H
+
+#include <memory>
+#include <string>
+
+namespace GPIO
+{
+    // Timing statistics of a SoftPWM. Lateness is how long after its scheduled time an edge was written.
+    struct SoftPWMStats
+    {
+        unsigned long long edges = 0;         // edges written
+        unsigned long long missed_cycles = 0; // whole periods skipped because the timer thread fell behind
+        long long max_lateness_ns = 0;
+        double mean_lateness_ns = 0.0;
+    };
+
+    /* PWM generated in software on any GPIO channel set up as OUT.
+       All the SoftPWM objects are driven by one timer thread, so the accuracy is limited by the scheduling
+       latency of the system (see stats()). Use PWM for the channels that have a hardware PWM controller. */
+    class SoftPWM
+    {
+    public:
+        SoftPWM(const std::string& channel, int frequency_hz);
+        SoftPWM(int channel, int frequency_hz);
+        SoftPWM(SoftPWM&& other);
+        SoftPWM& operator=(SoftPWM&& other);
+        SoftPWM(const SoftPWM&) = delete;
+        SoftPWM& operator=(const SoftPWM&) = delete;
+        ~SoftPWM();
+        void start(double duty_cycle_percent);
+        void stop(); // the channel is left LOW
+        void ChangeFrequency(int frequency_hz);
+        void ChangeDutyCycle(double duty_cycle_percent);
+
+        // statistics since the last start()
+        SoftPWMStats stats() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
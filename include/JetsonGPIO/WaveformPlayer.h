@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef WAVEFORM_PLAYER_H
+#define WAVEFORM_PLAYER_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GPIO
+{
+    /* One step of a waveform: at offset_ns after the start of the waveform, the channels selected by mask are
+       set to the matching bits of values. Bit i is the i-th channel of the WaveformPlayer. */
+    struct WaveformStep
+    {
+        int64_t offset_ns;
+        uint64_t mask;
+        uint64_t values;
+    };
+
+    // Timing of a waveform playback. Lateness is how long after its deadline a step was written.
+    struct WaveformStats
+    {
+        std::vector<long long> lateness_ns; // of each step in the last pass over the waveform
+        long long max_lateness_ns = 0;      // over all the passes
+        double mean_lateness_ns = 0.0;
+        unsigned long long steps = 0;  // steps written
+        unsigned long long passes = 0; // completed passes over the waveform
+        bool realtime = false;         // the playback thread got a real-time (SCHED_FIFO) priority
+    };
+
+    /* Plays precompiled waveforms on up to 64 channels that have already been set up as OUT, from a dedicated
+       thread that writes every step at its absolute CLOCK_MONOTONIC deadline. Steps that are late are written
+       as soon as possible, never skipped. The thread asks for a real-time priority, which requires
+       CAP_SYS_NICE (or root); without it the playback runs at normal priority.
+       Lines of the same gpio chip change with one system call when the backend supports it (GPIO::CDEV).
+       The playback follows the line requests merged or split by the backend (PinGroup, add_event_detect(), ...),
+       and stops with an error when one of the channels is cleaned up. */
+    class WaveformPlayer
+    {
+    public:
+        WaveformPlayer(const std::vector<std::string>& channels);
+        WaveformPlayer(const std::vector<int>& channels);
+        WaveformPlayer(const std::initializer_list<int>& channels);
+        WaveformPlayer(WaveformPlayer&& other);
+        WaveformPlayer& operator=(WaveformPlayer&& other);
+        WaveformPlayer(const WaveformPlayer&) = delete;
+        WaveformPlayer& operator=(const WaveformPlayer&) = delete;
+        ~WaveformPlayer(); // stops the playback
+
+        /* Play the steps once, starting now. The offsets must not decrease.
+           A playback in progress is stopped first. Returns without waiting for the end (see wait()). */
+        void play(const std::vector<WaveformStep>& steps);
+
+        // Play the steps repeatedly with a period of period_ns, which must be larger than the last offset.
+        void loop(const std::vector<WaveformStep>& steps, int64_t period_ns);
+
+        // Stop the playback. The channels keep the values of the last step written.
+        void stop();
+
+        // Wait for the end of a play(). Throws if the playback was stopped by an error.
+        void wait();
+
+        bool playing() const;
+
+        // statistics of the current or last playback
+        WaveformStats stats() const;
+
+        size_t size() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+
+} // namespace GPIO
+
+#endif
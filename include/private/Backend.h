@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "JetsonGPIO/PublicEnums.h"
+#include "private/ChannelInfo.h"
+#include "private/ChannelTable.h"
+
+namespace GPIO
+{
+    // An edge read from a file descriptor returned by Backend::open_edge()
+    struct EdgeRecord
+    {
+        Edge edge;             // UNKNOWN if the backend doesn't report the direction of the edge
+        int level;             // -1 if unknown
+        uint64_t timestamp_ns; // CLOCK_MONOTONIC. 0 if the backend doesn't record the time of the edge.
+    };
+
+    /* Kernel interface used to access the GPIO lines.
+       Functions throwing std::runtime_error on failure are wrapped by the public API.
+       Edge detection functions are called by the event module and return an EventResultCode instead. */
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+
+        virtual Backends type() const = 0;
+
+        // throws if the current user can't access the GPIO lines of the table
+        virtual void check_permission(const ChannelTable& table) const = 0;
+
+        /* Return the current configuration of a channel as reported by the kernel.
+           Any of IN, OUT, or UNKNOWN may be returned. */
+        virtual Directions direction(const ChannelInfo& ch_info) = 0;
+
+        // request the line of the channel. initial is HIGH, LOW or None.
+        virtual void setup_out(const ChannelInfo& ch_info, int initial) = 0;
+        virtual void setup_in(const ChannelInfo& ch_info) = 0;
+
+        // release the line of the channel. does nothing if the channel is not set up.
+        virtual void release(const ChannelInfo& ch_info) = 0;
+
+        // the channel must be set up
+        virtual void write(const ChannelInfo& ch_info, int value) = 0;
+        virtual int read(const ChannelInfo& ch_info) = 0;
+
+        /* The channels are going to be accessed together (PinGroup). Backends that can access several lines
+           with one system call request the lines of the same chip together. The channels must be set up. */
+        virtual void group(const std::vector<ChannelInfo>& ch_infos) = 0;
+
+        // Access the lines of a request at once. Bit i of mask and bits is the line with GPIOLine::index i.
+        virtual void write_lines(const LineRequest& request, uint64_t mask, uint64_t bits) = 0;
+        virtual uint64_t read_lines(const LineRequest& request, uint64_t mask) = 0;
+
+        /* Configure the edge to detect and return a new non-blocking file descriptor to wait for it with epoll.
+           The caller owns the file descriptor. */
+        virtual int open_edge(const ChannelInfo& ch_info, Edge edge, int& fd) = 0;
+
+        // Change the edge detected through a file descriptor returned by open_edge().
+        virtual int set_edge(const ChannelInfo& ch_info, Edge edge) = 0;
+
+        /* Let the kernel drop the bounces of a line detecting edges: an edge is reported once the line has been
+           stable for period_us. 0 turns it off. Returns false if the backend can't, the caller debounces then. */
+        virtual bool set_debounce(const ChannelInfo& ch_info, uint64_t period_us) = 0;
+
+        /* Consume the pending edges of a file descriptor returned by open_edge() after epoll reported it.
+           Returns the number of records written, at most max. Call it again while it returns max. */
+        virtual size_t read_edges(int fd, EdgeRecord* records, size_t max) = 0;
+
+        // true if the file descriptor is reported ready once right after it is added to an epoll set.
+        virtual bool initial_edge_event() const = 0;
+    };
+
+    std::shared_ptr<Backend> make_backend(Backends type);
+
+    // JETSON_GPIO_BACKEND environment variable ("sysfs" or "cdev"). SYSFS if not set.
+    Backends default_backend();
+} // namespace GPIO
+
+#endif // BACKEND_H
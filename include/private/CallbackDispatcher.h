@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef CALLBACK_DISPATCHER_H
+#define CALLBACK_DISPATCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JetsonGPIO/Callback.h"
+#include "JetsonGPIO/CallbackStats.h"
+#include "JetsonGPIO/EdgeEvent.h"
+#include "private/EventCounters.h"
+
+namespace GPIO
+{
+    // The callbacks of a channel. Replaced, never modified, so a queued event keeps the list it was detected with.
+    using CallbackList = std::vector<Callback>;
+
+    /* Call the callbacks with event, timing each call into counters (if not null).
+       The exceptions of the callbacks are reported to std::cerr. */
+    void run_callbacks(const CallbackList& callbacks, const EdgeEvent& event, EventCounters* counters);
+
+    /* Runs the callbacks of the detected events on a pool of worker threads, so that the event thread only has to
+       enqueue them. The events of one key (channel) are run one at a time in the order they were posted; events of
+       different keys run concurrently when there are several workers. */
+    class CallbackDispatcher
+    {
+    public:
+        CallbackDispatcher() = default;
+        CallbackDispatcher(const CallbackDispatcher&) = delete;
+        CallbackDispatcher& operator=(const CallbackDispatcher&) = delete;
+        ~CallbackDispatcher();
+
+        // Returns false (and counts a drop) if the queue is full. The calls are timed into counters (if not null).
+        bool post(int key, std::shared_ptr<const CallbackList> callbacks, const EdgeEvent& event,
+                  std::shared_ptr<EventCounters> counters = nullptr);
+
+        // Drop the events of key that are still queued. An event being run is not interrupted.
+        void discard(int key);
+
+        /* Wait until the callbacks of key being run (if any) have returned. Returns at once when called from them,
+           so that a callback can remove its own channel. Must not be called with a lock the callbacks may take. */
+        void wait_idle(int key);
+
+        // Must not be called from a callback. The workers are started again on the next post().
+        void set_workers(size_t workers);
+        void set_capacity(size_t capacity);
+
+        CallbackStats stats() const;
+
+    private:
+        struct QueuedEvent
+        {
+            std::shared_ptr<const CallbackList> callbacks;
+            EdgeEvent event;
+            std::shared_ptr<EventCounters> counters;
+        };
+
+        struct KeyQueue
+        {
+            std::deque<QueuedEvent> events;
+            bool scheduled = false; // in _ready or being run by a worker
+            bool running = false;   // its callbacks are being run by runner
+            std::thread::id runner;
+        };
+
+        void _start_workers();
+        void _stop_workers();
+        void _run();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::condition_variable _idle_cv; // notified when the callbacks of a key return
+        std::map<int, KeyQueue> _queues;
+        std::deque<int> _ready; // keys with queued events and no worker
+        std::vector<std::thread> _workers;
+        size_t _worker_count = 1;
+        size_t _capacity = 1024;
+        bool _stopping = false;
+        CallbackStats _stats;
+    };
+} // namespace GPIO
+
+#endif // CALLBACK_DISPATCHER_H
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef CDEV_BACKEND_H
+#define CDEV_BACKEND_H
+
+#include <sys/types.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "private/Backend.h"
+#include "private/FileDescriptor.h"
+
+namespace GPIO
+{
+    // System calls used by CdevBackend. Replaced in unit tests to run without a GPIO chip.
+    class CdevIO
+    {
+    public:
+        virtual ~CdevIO() = default;
+
+        virtual int open(const char* path, int flags);
+        virtual int ioctl(int fd, unsigned long request, void* arg);
+        virtual ssize_t read(int fd, void* buf, size_t count);
+    };
+
+    /* GPIO character device (/dev/gpiochip*, uAPI v2).
+       A line is requested from its chip on setup and accessed with GPIO_V2_LINE_{GET,SET}_VALUES_IOCTL
+       on the line request file descriptor. Edges are read from the same file descriptor.
+       Lines of a PinGroup are merged into one request per chip, unless they detect edges. */
+    class CdevBackend : public Backend
+    {
+    public:
+        explicit CdevBackend(std::shared_ptr<CdevIO> io = std::make_shared<CdevIO>());
+
+        Backends type() const override;
+        void check_permission(const ChannelTable& table) const override;
+        Directions direction(const ChannelInfo& ch_info) override;
+
+        void setup_out(const ChannelInfo& ch_info, int initial) override;
+        void setup_in(const ChannelInfo& ch_info) override;
+        void release(const ChannelInfo& ch_info) override;
+
+        void write(const ChannelInfo& ch_info, int value) override;
+        int read(const ChannelInfo& ch_info) override;
+
+        void group(const std::vector<ChannelInfo>& ch_infos) override;
+        void write_lines(const LineRequest& request, uint64_t mask, uint64_t bits) override;
+        uint64_t read_lines(const LineRequest& request, uint64_t mask) override;
+
+        int open_edge(const ChannelInfo& ch_info, Edge edge, int& fd) override;
+        int set_edge(const ChannelInfo& ch_info, Edge edge) override;
+        bool set_debounce(const ChannelInfo& ch_info, uint64_t period_us) override;
+        size_t read_edges(int fd, EdgeRecord* records, size_t max) override;
+        bool initial_edge_event() const override;
+
+    private:
+        struct Line;
+
+        std::shared_ptr<CdevIO> _io;
+        std::map<std::string, FileDescriptor> _chips; // chip character device path -> chip file descriptor
+
+        int _chip_fd(const std::string& chip);
+        void _request_lines(const std::string& chip, const std::vector<Line>& lines);
+        uint64_t _get_values(const LineRequest& request, uint64_t mask);
+
+        // Apply the flags and debounce periods of a request to its lines. throws on failure.
+        void _set_config(const LineRequest& request);
+
+        // Release a request. Returns its lines with their current configuration so that they can be requested again.
+        std::vector<Line> _release_request(const LineRequest& request);
+
+        // Move the line of the channel out of a request shared with other lines. The line is released if !keep.
+        void _isolate(const ChannelInfo& ch_info, bool keep);
+    };
+} // namespace GPIO
+
+#endif // CDEV_BACKEND_H
@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2019-2023, NVIDIA CORPORATION.
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef CHANNEL_INFO_H
+#define CHANNEL_INFO_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "private/GPIOLine.h"
+
+namespace GPIO
+{
+    struct ChannelInfo
+    {
+        const int id; // index of the pin in the channel table. the same pin has the same id in every numbering mode.
+        const std::string channel;
+        const std::string gpio_chip_dir;
+        const std::string gpio_chip_cdev; // character device of the gpio chip (e.g. /dev/gpiochip0). None if missing.
+        const int chip_gpio;              // line offset within the gpio chip
+        const int gpio;
+        const std::string gpio_name;
+        const std::string pwm_chip_dir;
+        const int pwm_id;
+
+        std::shared_ptr<GPIOLine> line;
+        std::shared_ptr<std::fstream> f_duty_cycle;
+
+        ChannelInfo(int id, const std::string& channel, const std::string& gpio_chip_dir,
+                    const std::string& gpio_chip_cdev, int chip_gpio, int gpio, const std::string& gpio_name,
+                    const std::string& pwm_chip_dir, int pwm_id)
+        : id(id),
+          channel(channel),
+          gpio_chip_dir(gpio_chip_dir),
+          gpio_chip_cdev(gpio_chip_cdev),
+          chip_gpio(chip_gpio),
+          gpio(gpio),
+          gpio_name(gpio_name),
+          pwm_chip_dir(pwm_chip_dir),
+          pwm_id(pwm_id),
+          line(std::make_shared<GPIOLine>()),
+          f_duty_cycle(std::make_shared<std::fstream>())
+        {
+        }
+    };
+} // namespace GPIO
+
+#endif // CHANNEL_INFO_H
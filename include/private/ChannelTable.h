@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef CHANNEL_TABLE_H
+#define CHANNEL_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "private/ChannelInfo.h"
+
+namespace GPIO
+{
+    /* Lookup table from a channel (pin number or signal name) to its ChannelInfo, for one numbering mode.
+       Numeric channels (BOARD, BCM) resolve through a dense array indexed by the pin number,
+       and channel names through a perfect hash that is built once when the table is constructed. */
+    class ChannelTable
+    {
+    public:
+        ChannelTable() = default;
+
+        // channels[i].id must be i
+        explicit ChannelTable(std::vector<ChannelInfo> channels);
+
+        // returns nullptr if the channel is not in the table
+        const ChannelInfo* find(int channel) const;
+        const ChannelInfo* find(const std::string& channel) const;
+
+        inline const ChannelInfo& operator[](size_t id) const { return _channels[id]; }
+        inline size_t size() const { return _channels.size(); }
+
+        inline std::vector<ChannelInfo>::const_iterator begin() const { return _channels.begin(); }
+        inline std::vector<ChannelInfo>::const_iterator end() const { return _channels.end(); }
+
+    private:
+        std::vector<ChannelInfo> _channels;
+        std::vector<int> _by_number; // pin number -> id (-1 if none)
+        std::vector<int> _by_name;   // perfect hash slot -> id (-1 if none)
+        uint32_t _seed = 0;
+
+        static uint32_t _hash(const std::string& s, uint32_t seed);
+        void _build_number_index();
+        void _build_name_index();
+    };
+} // namespace GPIO
+
+#endif // CHANNEL_TABLE_H
@@ -0,0 +1,51 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef EDGE_SINK_H
+#define EDGE_SINK_H
+
+#include <cstdint>
+#include <vector>
+
+#include "JetsonGPIO/PublicEnums.h"
+
+namespace GPIO
+{
+    /* Takes the edges of a channel in the epoll thread instead of events (see _add_edge_sink()): no EdgeEvent is
+       made, and no callback is called. Used by the measurements that must keep up with fast inputs. */
+    class EdgeSink
+    {
+    public:
+        virtual ~EdgeSink() = default;
+
+        /* Called by the epoll thread only, with _epmutex held, so it must not block.
+           edge is RISING or FALLING, or UNKNOWN if the backend doesn't tell it. level is -1 if unknown. */
+        virtual void on_edge(int gpio, Edge edge, int level, uint64_t timestamp_ns) = 0;
+
+        /* Called once by _add_edge_sinks() before any call to on_edge(): the levels of the channels (in the order
+           they were given) just before the edge detection started. */
+        virtual void on_start(const std::vector<int>& levels) {}
+    };
+} // namespace GPIO
+
+#endif // EDGE_SINK_H
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef EVENT_COUNTERS_H
+#define EVENT_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "JetsonGPIO/EventStats.h"
+
+namespace GPIO
+{
+    // Durations in buckets of powers of 2, with their count and maximum. Relaxed atomics.
+    class DurationHistogram
+    {
+    public:
+        void add(uint64_t duration_ns);
+
+        unsigned long long count() const { return _count.load(std::memory_order_relaxed); }
+        uint64_t max() const { return _max_ns.load(std::memory_order_relaxed); }
+
+        // upper bound of the duration of the given rank (0.5: median), at most max(). 0 if there is none.
+        uint64_t percentile(double fraction) const;
+
+    private:
+        // bucket i counts the durations of i significant bits: [2^(i-1), 2^i)
+        static constexpr size_t BUCKETS = 65;
+
+        std::atomic<unsigned long long> _count{0};
+        std::atomic<uint64_t> _max_ns{0};
+        std::atomic<unsigned long long> _buckets[BUCKETS]{};
+    };
+
+    /* The counters of a channel with edge detection. Written by the event thread (edges) and by the threads that
+       call the callbacks, read by event_stats() from any thread: all relaxed atomics, so a snapshot may mix the
+       values from before and after an edge. */
+    class EventCounters
+    {
+    public:
+        explicit EventCounters(const std::string& channel) : _channel(channel) {}
+
+        void add_edge() { _edges.fetch_add(1, std::memory_order_relaxed); }
+        void add_debounced() { _debounced.fetch_add(1, std::memory_order_relaxed); }
+        void add_glitch() { _glitches.fetch_add(1, std::memory_order_relaxed); }
+        void add_callback(uint64_t duration_ns) { _callbacks.add(duration_ns); }
+        void add_reflex(uint64_t latency_ns) { _reflexes.add(latency_ns); }
+        void add_reflex_error() { _reflex_errors.fetch_add(1, std::memory_order_relaxed); }
+        void set_kernel_debounce(bool on) { _kernel_debounce.store(on, std::memory_order_relaxed); }
+
+        ChannelEventStats read() const;
+
+    private:
+        const std::string _channel;
+        std::atomic<unsigned long long> _edges{0};
+        std::atomic<unsigned long long> _debounced{0};
+        std::atomic<unsigned long long> _glitches{0};
+        std::atomic<bool> _kernel_debounce{false};
+        DurationHistogram _callbacks;
+        DurationHistogram _reflexes; // reaction latencies
+        std::atomic<unsigned long long> _reflex_errors{0};
+    };
+} // namespace GPIO
+
+#endif // EVENT_COUNTERS_H
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef FILE_DESCRIPTOR_H
+#define FILE_DESCRIPTOR_H
+
+#include <string>
+
+namespace GPIO
+{
+    // RAII wrapper of a raw file descriptor.
+    // Used for the files touched on every I/O call (e.g. sysfs value files), where
+    // going through std::fstream would cost extra syscalls, buffering and locale formatting.
+    class FileDescriptor
+    {
+    public:
+        FileDescriptor() = default;
+        explicit FileDescriptor(int fd);
+        FileDescriptor(FileDescriptor&& other) noexcept;
+        FileDescriptor& operator=(FileDescriptor&& other) noexcept;
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+        ~FileDescriptor();
+
+        // returns false on failure (errno is set)
+        bool open(const std::string& path, int flags);
+        void close();
+        int release();
+
+        inline int get() const { return _fd; }
+        inline bool is_open() const { return _fd >= 0; }
+
+        /* Single-syscall access to a one-character attribute at offset 0.
+           write_char() returns false on failure (errno is set).
+           read_char() returns the character read, or -1 on failure. */
+        bool write_char(char c) const;
+        int read_char() const;
+
+    private:
+        int _fd = -1;
+    };
+} // namespace GPIO
+
+#endif
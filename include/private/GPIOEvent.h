@@ -28,9 +28,18 @@ DEALINGS IN THE SOFTWARE.
 #define GPIO_EVENT_H
 
 #include "JetsonGPIO/Callback.h"
+#include "JetsonGPIO/CallbackStats.h"
+#include "JetsonGPIO/EventStats.h"
 #include "JetsonGPIO/PublicEnums.h"
+#include "private/Backend.h"
+#include "private/EdgeSink.h"
+#include "private/EventRing.h"
+#include "private/PulseCounter.h"
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace GPIO
 {
@@ -50,26 +59,89 @@ namespace GPIO
         EpollCTL_Add = -111,
         EpollWait = -112,
         GPIO_Event_Not_Found = -113,
+        CdevLine_EdgeConfig = -114,
+        CdevLine_EventFD = -115,
+        EpollWakeFD_CreateError = -116,
+        EdgeSinkConflict = -117,
+        EventThreadRunning = -118,
+        EventLoopNotEmbedded = -119,
         None = 0,
         EdgeDetected = 1,
     };
 
     extern std::map<EventResultCode, const char*> event_error_code_to_message;
 
-    int _blocking_wait_for_edge(int gpio, const std::string& gpio_name, const std::string& channel_id, Edge edge,
+    int _blocking_wait_for_edge(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
                                 uint64_t bounce_time, uint64_t timeout);
 
+    /* Wait for an edge on any of the channels. detected gets the first edge of each channel that fired,
+       returns EdgeDetected, None on timeout or an error code. */
+    int _blocking_wait_for_edges(const std::shared_ptr<Backend>& backend, const std::vector<ChannelInfo>& ch_infos,
+                                 Edge edge, uint64_t bounce_time, uint64_t timeout, std::vector<EdgeEvent>& detected);
+
     bool _edge_event_detected(int gpio);
     bool _edge_event_exists(int gpio);
 
-    int _add_edge_detect(int gpio, const std::string& gpio_name, const std::string& channel_id, Edge edge,
+    int _add_edge_detect(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
                          uint64_t bounce_time);
+    // returns once no callback of the channel is running, unless called from one of them
     void _remove_edge_detect(int gpio);
 
     int _add_edge_callback(int gpio, const Callback& callback);
     void _remove_edge_callback(int gpio, const Callback& callback);
 
-    void _event_cleanup(int gpio, const std::string& gpio_name);
+    // event buffers. a size of 0 removes the buffer of gpio.
+    int _set_event_buffer(int gpio, size_t size);
+    std::shared_ptr<EventRing> _event_buffer(int gpio); // nullptr if gpio has no buffer
+
+    /* Glitch filter of a channel with event detection: an edge is delivered only if the channel still has its level
+       window_ns after it, with no other edge in between. 0 removes the filter. */
+    int _set_glitch_filter(const ChannelInfo& ch_info, uint64_t window_ns);
+
+    /* Reflex of a channel with event detection: the event thread writes output (0 or 1, -1 toggles it) when it
+       detects edge (RISING, FALLING or BOTH), before the event is fired. Removed by _remove_edge_detect() or when
+       output is cleaned up (_event_cleanup()). */
+    int _add_reflex(const ChannelInfo& input, Edge edge, const ChannelInfo& output, int value);
+    void _clear_reflexes(int gpio);
+    std::vector<bool> _reflex_outputs(size_t channel_count); // [ChannelInfo::id]: written by a reflex
+
+    /* Set up edge detection for gpio with the edges given to sink instead of events.
+       Fails with EdgeSinkConflict if gpio already detects events, and the other way around. */
+    int _add_edge_sink(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
+                       const std::shared_ptr<EdgeSink>& sink);
+    /* Same for several channels giving their edges to one sink. Either all the channels are set up or none,
+       and sink->on_start() is called with their levels before the edge detection starts. */
+    int _add_edge_sinks(const std::shared_ptr<Backend>& backend, const std::vector<ChannelInfo>& ch_infos, Edge edge,
+                        const std::shared_ptr<EdgeSink>& sink);
+    // remove the edge detection of gpio if it still gives the edges to sink
+    void _remove_edge_sink(int gpio, const std::shared_ptr<EdgeSink>& sink);
+
+    // pulse counters. removed by _remove_edge_detect().
+    int _add_pulse_counter(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge);
+    std::shared_ptr<PulseCounter> _pulse_counter(int gpio); // nullptr if gpio has no counter
+
+    // callback workers. throw std::runtime_error if the argument is 0.
+    void _set_callback_workers(size_t workers);
+    void _set_callback_queue_size(size_t size);
+    CallbackStats _callback_stats();
+
+    // counters of the event loop and of the channels in it. doesn't wait for the event thread.
+    EventStats _event_stats();
+
+    /* Embedded event loop: no event thread, the caller polls the fd and calls _process_events().
+       _event_fd() switches to it on the first call and returns the fd, or an error code (negative). */
+    int _event_fd();
+    // Handles the ready edges and the changes without waiting, with the callbacks called on this thread.
+    // Returns the number of edges handled, or an error code (negative). One thread at a time.
+    int _process_events();
+
+    // the channel is cleaned up: its edge detection and the reflexes writing it are removed
+    void _event_cleanup(int gpio);
+
+    /* Held while the line requests of set up channels are replaced (Backend::release(), Backend::group()), since the
+       event thread writes the outputs of the reflexes through them. Must not be held while edge detection is
+       removed: that may wait for the event thread. */
+    std::unique_lock<std::recursive_mutex> _lock_line_requests();
 } // namespace GPIO
 
 #endif
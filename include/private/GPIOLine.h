@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_LINE_H
+#define GPIO_LINE_H
+
+#include <memory>
+
+#include "private/FileDescriptor.h"
+
+namespace GPIO
+{
+    // Lines requested from the kernel together and accessed through one file descriptor.
+    // What the descriptor refers to depends on the backend (a sysfs value file, a gpio-cdev line request, ...).
+    struct LineRequest
+    {
+        FileDescriptor fd;
+
+        virtual ~LineRequest() = default;
+    };
+
+    // Backend state of a channel. Shared by all copies of the channel's ChannelInfo.
+    struct GPIOLine
+    {
+        std::shared_ptr<LineRequest> request; // nullptr if the channel is not set up
+        unsigned index = 0;                   // index of the line in the request
+    };
+
+    /* Compares the owners, not the addresses: a request released by the backend may be followed by a new one at the
+       same address, with another layout of lines. */
+    inline bool _same_request(const std::weak_ptr<LineRequest>& request, const std::shared_ptr<LineRequest>& current)
+    {
+        return !request.owner_before(current) && !current.owner_before(request);
+    }
+} // namespace GPIO
+
+#endif // GPIO_LINE_H
@@ -27,8 +27,11 @@ DEALINGS IN THE SOFTWARE.
 #ifndef MAIN_MODULE_H
 #define MAIN_MODULE_H
 
+#include "JetsonGPIO/OutputStats.h"
+#include "private/Backend.h"
 #include "private/GPIOPinData.h"
 #include "private/PythonFunctions.h"
+#include "private/SoftPWMScheduler.h"
 
 namespace GPIO
 {
@@ -40,17 +43,34 @@ namespace GPIO
         PinData _pinData;
         std::string _model;
         std::string _JETSON_INFO;
-        std::string _gpio_dir(const ChannelInfo& ch_info);
 
     public:
-        const std::map<GPIO::NumberingModes, std::map<std::string, ChannelInfo>> _channel_data_by_mode;
+        const std::map<GPIO::NumberingModes, ChannelTable> _channel_data_by_mode;
 
-        // A map used as lookup tables for pin to linux gpio mapping
-        std::map<std::string, ChannelInfo> _channel_data;
+        // A table used for pin to linux gpio mapping in the current numbering mode (nullptr if the mode is not set)
+        const ChannelTable* _channel_data;
 
         bool _gpio_warnings;
         NumberingModes _gpio_mode;
-        std::map<std::string, Directions> _channel_configuration;
+
+        // indexed by ChannelInfo::id. UNKNOWN if the channel is not set up.
+        std::vector<Directions> _channel_configuration;
+
+        // kernel interface used to access the GPIO lines. can only be changed before the mode is set.
+        std::shared_ptr<Backend> _backend;
+
+        // output shadow registers, indexed by ChannelInfo::id. the last value written (0 or 1), -1 if unknown.
+        std::vector<int> _output_shadow;
+        // channels written by reflexes in the event thread (add_reflex()): their shadow stays unknown
+        std::vector<bool> _reflex_output;
+        std::vector<OutputStats> _output_stats;
+        OutputStats _output_stats_total;
+
+        // skip writes of the value a channel already has
+        bool _output_cache;
+
+        // timer thread of the SoftPWM objects
+        SoftPWMScheduler _soft_pwm;
 
         MainModule(const MainModule&) = delete;
         MainModule& operator=(const MainModule&) = delete;
@@ -59,25 +79,47 @@ namespace GPIO
         static MainModule& get_instance();
 
         void _validate_mode_set();
-        ChannelInfo _channel_to_info_lookup(const std::string& channel, bool need_gpio, bool need_pwm);
-        ChannelInfo _channel_to_info(const std::string& channel, bool need_gpio = false, bool need_pwm = false);
+        const ChannelInfo& _channel_to_info_lookup(const std::string& channel, bool need_gpio, bool need_pwm);
+        const ChannelInfo& _channel_to_info_lookup(int channel, bool need_gpio, bool need_pwm);
+        const ChannelInfo& _channel_to_info(const std::string& channel, bool need_gpio = false, bool need_pwm = false);
+        const ChannelInfo& _channel_to_info(int channel, bool need_gpio = false, bool need_pwm = false);
 
         std::vector<ChannelInfo> _channels_to_infos(const std::vector<std::string>& channels, bool need_gpio = false,
                                                     bool need_pwm = false);
+        std::vector<ChannelInfo> _channels_to_infos(const std::vector<int>& channels, bool need_gpio = false,
+                                                    bool need_pwm = false);
 
-        /* Return the current configuration of a channel as reported by sysfs.
+        /* Return the current configuration of a channel as reported by the kernel.
            Any of IN, OUT, HARD_PWM, or UNKNOWN may be returned. */
-        Directions _sysfs_channel_configuration(const ChannelInfo& ch_info);
+        Directions _system_channel_configuration(const ChannelInfo& ch_info);
 
         /* Return the current configuration of a channel as requested by this
            module in this process. Any of IN, OUT, or UNKNOWN may be returned. */
         Directions _app_channel_configuration(const ChannelInfo& ch_info);
 
-        void _export_gpio(const ChannelInfo& ch_info);
+        void _output_one(const ChannelInfo& ch_info, const int value);
 
-        void _unexport_gpio(const ChannelInfo& ch_info);
+        // invert the value of a channel set up as OUT. uses the shadow register if the value is known.
+        void _toggle_one(const ChannelInfo& ch_info);
 
-        void _output_one(const ChannelInfo& ch_info, const int value);
+        /* Record the values written to up to 64 channels at once. bit i of mask and values is ch_infos[i].
+           Returns the bits of mask that must be written: only those whose shadow differs if the output cache is
+           enabled, mask otherwise. */
+        uint64_t _shadow_many(const std::vector<ChannelInfo>& ch_infos, uint64_t mask, uint64_t values);
+
+        int _input_one(const ChannelInfo& ch_info);
+
+        /* Read up to 64 channels that are set up. The lines sharing a request are read with one call and
+           all requests are read before the result is assembled. bit i of the result is ch_infos[i]. */
+        uint64_t _input_many(const ChannelInfo* const* ch_infos, size_t count);
+
+        /* Let the backend request the lines of the channels together (PinGroup, InputGroup, WaveformPlayer).
+           Holds the locks of the event module and of the SoftPWM thread: the reflexes and the SoftPWMs write
+           their channels through the line requests. */
+        void _group(const std::vector<ChannelInfo>& ch_infos);
+
+        // reflexes were added or removed: update _reflex_output
+        void _update_reflex_outputs();
 
         void _setup_single_out(const ChannelInfo& ch_info, int initial = None);
 
@@ -109,8 +151,6 @@ namespace GPIO
 
         void _cleanup_one(const ChannelInfo& ch_info);
 
-        void _cleanup_one(const std::string& channel);
-
         void _cleanup_all();
 
         void _warn_if_no_channel_to_cleanup();
@@ -121,7 +161,6 @@ namespace GPIO
 
     private:
         MainModule();
-        void _check_permission() const;
     };
 
     // alias (only for implementation)
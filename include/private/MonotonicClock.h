@@ -0,0 +1,48 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef MONOTONIC_CLOCK_H
+#define MONOTONIC_CLOCK_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace GPIO
+{
+    // current time of CLOCK_MONOTONIC in nanoseconds
+    int64_t _monotonic_ns();
+
+    // sleep until the CLOCK_MONOTONIC time deadline_ns (absolute). returns immediately if it has passed.
+    void _sleep_until_ns(int64_t deadline_ns);
+
+    /* Wait until the CLOCK_MONOTONIC time deadline_ns for a thread that must stay responsive while it waits.
+       Long waits are done on cv (notify it after making interrupted() true); the last fraction of a millisecond
+       is slept with _sleep_until_ns() without holding the lock. lock is held again on return.
+       Returns false if interrupted() became true before the precise sleep. */
+    bool _wait_until_ns(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, int64_t deadline_ns,
+                        const std::function<bool()>& interrupted);
+} // namespace GPIO
+
+#endif // MONOTONIC_CLOCK_H
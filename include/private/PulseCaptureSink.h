@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef PULSE_CAPTURE_SINK_H
+#define PULSE_CAPTURE_SINK_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "JetsonGPIO/PulseCapture.h"
+#include "private/EdgeSink.h"
+#include "private/SpscRing.h"
+
+namespace GPIO
+{
+    /* The measurements of a PulseCapture, made from the edges in the event thread. The statistics are separate
+       atomics written by the event thread only, so stats() takes no lock but may mix the values from before and
+       after a pulse. */
+    class PulseCaptureSink : public EdgeSink
+    {
+    public:
+        explicit PulseCaptureSink(size_t capacity);
+
+        void on_edge(int gpio, Edge edge, int level, uint64_t timestamp_ns) override;
+
+        size_t read(PulseMeasurement* measurements, size_t max) { return _measurements.pop(measurements, max); }
+        PulseCaptureStats stats() const;
+
+    private:
+        // event thread only
+        uint64_t _last_rise_ns = 0;
+        uint64_t _period_ns = 0;
+        bool _high = false; // a rising edge waits for its falling edge
+
+        SpscRing<PulseMeasurement> _measurements;
+
+        std::atomic<unsigned long long> _pulses{0};
+        std::atomic<uint64_t> _min_width_ns{0};
+        std::atomic<uint64_t> _max_width_ns{0};
+        std::atomic<uint64_t> _total_width_ns{0};
+
+        std::atomic<unsigned long long> _periods{0};
+        std::atomic<uint64_t> _min_period_ns{0};
+        std::atomic<uint64_t> _max_period_ns{0};
+        std::atomic<uint64_t> _total_period_ns{0};
+    };
+} // namespace GPIO
+
+#endif // PULSE_CAPTURE_SINK_H
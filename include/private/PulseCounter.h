@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef PULSE_COUNTER_H
+#define PULSE_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "JetsonGPIO/PulseCount.h"
+#include "private/EdgeSink.h"
+
+namespace GPIO
+{
+    /* Edge count and rate of a channel. add() is called by the event thread only; read() can be called by any
+       thread at any time. Neither takes a lock: every value is a separate atomic, so a read racing with an edge
+       may mix the values from before and after it. */
+    class PulseCounter : public EdgeSink
+    {
+    public:
+        // weight of the last interval in the moving average: 1 / 2^average_shift
+        static constexpr int average_shift = 3;
+
+        void add(uint64_t timestamp_ns);
+        void on_edge(int gpio, Edge edge, int level, uint64_t timestamp_ns) override;
+        PulseCount read(uint64_t now_ns) const;
+
+    private:
+        std::atomic<unsigned long long> _count{0};
+        std::atomic<uint64_t> _last_ns{0};
+        std::atomic<uint64_t> _interval_ns{0};
+        std::atomic<uint64_t> _average_interval_ns{0};
+    };
+} // namespace GPIO
+
+#endif // PULSE_COUNTER_H
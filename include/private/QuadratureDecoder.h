@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef QUADRATURE_DECODER_H
+#define QUADRATURE_DECODER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "private/EdgeSink.h"
+
+namespace GPIO
+{
+    /* The state machine of a QuadratureEncoder, given the edges of both channels in the event thread.
+       The state is the levels of A and B (A << 1 | B). The results are atomics written by the event thread only. */
+    class QuadratureDecoder : public EdgeSink
+    {
+    public:
+        QuadratureDecoder(int gpio_a, int gpio_b);
+
+        void on_start(const std::vector<int>& levels) override; // levels of A and B
+        void on_edge(int gpio, Edge edge, int level, uint64_t timestamp_ns) override;
+
+        int64_t position() const { return _position.load(std::memory_order_relaxed); }
+        int direction() const { return _direction.load(std::memory_order_relaxed); }
+        unsigned long long errors() const { return _errors.load(std::memory_order_relaxed); }
+
+    private:
+        const int _gpio_a;
+        const int _gpio_b;
+
+        // event thread only
+        unsigned _state = 0;
+
+        std::atomic<int64_t> _position{0};
+        std::atomic<int> _direction{0};
+        std::atomic<unsigned long long> _errors{0};
+    };
+} // namespace GPIO
+
+#endif // QUADRATURE_DECODER_H
@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef SOFT_PWM_SCHEDULER_H
+#define SOFT_PWM_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "JetsonGPIO/SoftPWM.h"
+#include "private/Backend.h"
+#include "private/ChannelInfo.h"
+
+namespace GPIO
+{
+    /* Drives every SoftPWM from one thread. The next edge of each channel is kept in a min-heap ordered by
+       its absolute CLOCK_MONOTONIC deadline; the thread sleeps until the earliest one with clock_nanosleep
+       (TIMER_ABSTIME) and writes the edges that are due together, one write_lines() per line request.
+       A changed frequency or duty cycle takes effect at the next period. */
+    class SoftPWMScheduler
+    {
+    public:
+        struct Handle
+        {
+            size_t slot = 0;
+            uint64_t generation = 0; // 0: not running
+        };
+
+        SoftPWMScheduler() = default;
+        SoftPWMScheduler(const SoftPWMScheduler&) = delete;
+        SoftPWMScheduler& operator=(const SoftPWMScheduler&) = delete;
+        ~SoftPWMScheduler();
+
+        /* Start driving a channel set up as OUT. high_ns is clamped to [0, period_ns]: 0 and period_ns hold the
+           line LOW and HIGH. The line request of the channel is looked up on every write, so the backend may
+           replace it (Backend::group(), release() of a merged line) while holding lock_lines(). */
+        Handle add(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, int64_t period_ns,
+                   int64_t high_ns);
+
+        void update(const Handle& handle, int64_t period_ns, int64_t high_ns);
+
+        /* Stop driving the channel and write LOW to it. Returns false if it was not running.
+           No edge of the channel is written after this returns. */
+        bool remove(const Handle& handle);
+
+        // remove the channel with ChannelInfo::id id if it is running (cleanup)
+        void remove_channel(int id);
+
+        // Held while the line requests of set up channels are replaced: no edge is written meanwhile
+        std::unique_lock<std::mutex> lock_lines() { return std::unique_lock<std::mutex>(_mutex); }
+
+        bool running(const Handle& handle) const;
+        SoftPWMStats stats(const Handle& handle) const;
+
+    private:
+        struct Slot
+        {
+            uint64_t generation = 0; // 0: free
+            std::shared_ptr<Backend> backend;
+            std::shared_ptr<GPIOLine> line; // not its request: that one would keep the line busy when it is replaced
+            int id = 0;
+            int64_t period_ns = 0;
+            int64_t high_ns = 0;
+            int64_t cycle_start = 0;
+            bool pending = false; // an edge of the current generation is in the schedule
+            SoftPWMStats stats;
+            long double lateness_sum_ns = 0;
+        };
+
+        struct Edge
+        {
+            int64_t deadline;
+            size_t slot;
+            uint64_t generation;
+            bool high;
+
+            bool operator>(const Edge& other) const { return deadline > other.deadline; }
+        };
+
+        struct Write
+        {
+            Backend* backend;
+            const LineRequest* request;
+            uint64_t mask;
+            uint64_t bits;
+        };
+
+        Slot* _find(const Handle& handle);
+        const Slot* _find(const Handle& handle) const;
+        void _free(Slot& slot);
+        void _schedule_edge(int64_t deadline, size_t slot, bool high);
+        void _notify();
+        void _run();
+        void _write_due(int64_t now);
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::vector<Slot> _slots;
+        std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> _schedule;
+        std::vector<Write> _writes; // reused by the timer thread
+        uint64_t _next_generation = 1;
+        bool _changed = false;
+        bool _stopping = false;
+        std::thread _thread;
+    };
+} // namespace GPIO
+
+#endif // SOFT_PWM_SCHEDULER_H
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace GPIO
+{
+    /* Bounded single-producer single-consumer queue.
+       push() is called by one producer thread (the event thread), pop() by one reader thread at a time.
+       Neither takes a lock. When the queue is full, the new item is dropped and counted as an overflow. */
+    template <class T> class SpscRing
+    {
+    public:
+        explicit SpscRing(size_t capacity) : _slots(capacity)
+        {
+            if (capacity == 0)
+                throw std::runtime_error("The buffer size must be at least 1");
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // producer. returns false if the queue is full.
+        bool push(const T& item)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) >= _slots.size())
+            {
+                _overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // copy-assigned, so a slot reuses the storage of its members (e.g. strings)
+            _slots[tail % _slots.size()] = item;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer. copies up to max of the oldest items to items, removes them and returns the number of them.
+        size_t pop(T* items, size_t max)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            size_t count = std::min(max, _tail.load(std::memory_order_acquire) - head);
+
+            for (size_t i = 0; i < count; i++)
+                items[i] = _slots[(head + i) % _slots.size()];
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t capacity() const { return _slots.size(); }
+
+        size_t size() const
+        {
+            size_t head = _head.load(std::memory_order_acquire);
+            return _tail.load(std::memory_order_acquire) - head;
+        }
+
+        unsigned long long overflows() const { return _overflows.load(std::memory_order_relaxed); }
+
+    private:
+        std::vector<T> _slots;
+
+        // free-running counters, the slot of an index is index % capacity.
+        // kept on separate cache lines so that the producer and the consumer don't share one.
+        std::atomic<size_t> _head{0}; // next index to pop, written by the consumer
+        char _head_padding[64 - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> _tail{0}; // next index to push, written by the producer
+        char _tail_padding[64 - sizeof(std::atomic<size_t>)];
+        std::atomic<unsigned long long> _overflows{0};
+    };
+} // namespace GPIO
+
+#endif // SPSC_RING_H
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef SYSFS_BACKEND_H
+#define SYSFS_BACKEND_H
+
+#include <string>
+
+#include "private/Backend.h"
+
+namespace GPIO
+{
+    // /sys/class/gpio. A line is exported on setup and accessed through its value file.
+    class SysfsBackend : public Backend
+    {
+    public:
+        Backends type() const override;
+        void check_permission(const ChannelTable& table) const override;
+        Directions direction(const ChannelInfo& ch_info) override;
+
+        void setup_out(const ChannelInfo& ch_info, int initial) override;
+        void setup_in(const ChannelInfo& ch_info) override;
+        void release(const ChannelInfo& ch_info) override;
+
+        void write(const ChannelInfo& ch_info, int value) override;
+        int read(const ChannelInfo& ch_info) override;
+
+        void group(const std::vector<ChannelInfo>& ch_infos) override;
+        void write_lines(const LineRequest& request, uint64_t mask, uint64_t bits) override;
+        uint64_t read_lines(const LineRequest& request, uint64_t mask) override;
+
+        int open_edge(const ChannelInfo& ch_info, Edge edge, int& fd) override;
+        int set_edge(const ChannelInfo& ch_info, Edge edge) override;
+        bool set_debounce(const ChannelInfo& ch_info, uint64_t period_us) override;
+        size_t read_edges(int fd, EdgeRecord* records, size_t max) override;
+        bool initial_edge_event() const override;
+
+    private:
+        std::string _gpio_dir(const ChannelInfo& ch_info) const;
+        void _export_gpio(const ChannelInfo& ch_info, const char* direction);
+    };
+} // namespace GPIO
+
+#endif // SYSFS_BACKEND_H
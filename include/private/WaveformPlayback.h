@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef WAVEFORM_PLAYBACK_H
+#define WAVEFORM_PLAYBACK_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "JetsonGPIO/WaveformPlayer.h"
+#include "private/Backend.h"
+#include "private/ChannelInfo.h"
+
+namespace GPIO
+{
+    /* Plays the waveforms of a WaveformPlayer from a dedicated thread. The steps are compiled to writes per line
+       request. The requests are looked up before each step with _lock_line_requests() held, so the backend may
+       replace them (Backend::group(), release() of a merged line, open_edge()) during the playback: the waveform
+       is then compiled again for the new requests. The playback stops with an error when a channel is released. */
+    class WaveformPlayback
+    {
+    public:
+        // the channels must be set up as OUT
+        WaveformPlayback(const std::shared_ptr<Backend>& backend, const std::vector<ChannelInfo>& ch_infos);
+        WaveformPlayback(const WaveformPlayback&) = delete;
+        WaveformPlayback& operator=(const WaveformPlayback&) = delete;
+        ~WaveformPlayback(); // stops the playback
+
+        // Start playing the steps, once if period_ns is 0. A playback in progress is stopped first.
+        void start(const std::vector<WaveformStep>& steps, int64_t period_ns);
+
+        void stop();
+
+        // Wait for the end of the playback. Returns the error that stopped it, empty if there was none.
+        std::string wait();
+
+        bool playing() const;
+        WaveformStats stats() const;
+
+    private:
+        // the channels that share a line request
+        struct Segment
+        {
+            std::weak_ptr<LineRequest> request;              // the request when the waveform was compiled
+            std::shared_ptr<GPIOLine> line;                  // a line of the request
+            std::vector<std::pair<unsigned, unsigned>> bits; // (bit in the player, GPIOLine::index)
+        };
+
+        // the bits of one step that belong to one segment
+        struct Write
+        {
+            size_t segment;
+            uint64_t mask;
+            uint64_t bits;
+        };
+
+        void _check_steps(const std::vector<WaveformStep>& steps) const;
+        void _compile();
+        bool _requests_changed() const;
+        void _run();
+
+        std::vector<ChannelInfo> _ch_infos;
+        std::shared_ptr<Backend> _backend;
+
+        // compiled waveform. the writes of step i are _writes[_step_begin[i]] to _writes[_step_begin[i + 1] - 1].
+        std::vector<WaveformStep> _steps;
+        std::vector<Segment> _segments;
+        std::vector<size_t> _step_begin;
+        std::vector<Write> _writes;
+        int64_t _period_ns = 0; // 0: play once
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::thread _thread;
+        bool _stopping = false;
+        bool _playing = false;
+        std::string _failure; // error that stopped the playback
+        WaveformStats _stats;
+        long double _lateness_sum_ns = 0;
+    };
+} // namespace GPIO
+
+#endif // WAVEFORM_PLAYBACK_H
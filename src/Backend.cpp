@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/Backend.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include "private/CdevBackend.h"
+#include "private/PythonFunctions.h"
+#include "private/SysfsBackend.h"
+
+namespace GPIO
+{
+    std::shared_ptr<Backend> make_backend(Backends type)
+    {
+        switch (type)
+        {
+        case Backends::SYSFS:
+            return std::make_shared<SysfsBackend>();
+        case Backends::CDEV:
+            return std::make_shared<CdevBackend>();
+        default:
+            throw std::runtime_error("Invalid backend");
+        }
+    }
+
+    Backends default_backend()
+    {
+        const char* env = std::getenv("JETSON_GPIO_BACKEND");
+        if (env == nullptr)
+            return Backends::SYSFS;
+
+        std::string name = lower(strip(env));
+        if (name.empty() || name == "sysfs")
+            return Backends::SYSFS;
+        if (name == "cdev")
+            return Backends::CDEV;
+
+        throw std::runtime_error("Invalid JETSON_GPIO_BACKEND: " + name + " (must be sysfs or cdev)");
+    }
+} // namespace GPIO
@@ -24,13 +24,75 @@ DEALINGS IN THE SOFTWARE.
 
 namespace GPIO
 {
-    void Callback::operator()(const std::string& input) const
+    Callback::Callback(function_t function, void* context)
+    : Callback(function != nullptr ? Callback(details::ContextCallback{function, context}) : Callback(nullptr))
     {
-        if (function != nullptr)
-            function(input);
     }
 
-    bool operator==(const Callback& A, const Callback& B) { return A.comparer(A.function, B.function); }
+    Callback::Callback(const Callback& other) : _ops(other._ops)
+    {
+        if (_ops != nullptr)
+            _ops->copy(_buffer, other._buffer);
+    }
+
+    Callback::Callback(Callback&& other) noexcept : _ops(other._ops)
+    {
+        if (_ops != nullptr)
+        {
+            _ops->move(_buffer, other._buffer);
+            other._ops = nullptr;
+        }
+    }
+
+    Callback::~Callback() { _reset(); }
+
+    Callback& Callback::operator=(const Callback& other)
+    {
+        if (this != &other)
+        {
+            Callback copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    Callback& Callback::operator=(Callback&& other) noexcept
+    {
+        if (this != &other)
+        {
+            _reset();
+            if (other._ops != nullptr)
+            {
+                other._ops->move(_buffer, other._buffer);
+                _ops = other._ops;
+                other._ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    void Callback::_reset() noexcept
+    {
+        if (_ops != nullptr)
+        {
+            _ops->destroy(_buffer);
+            _ops = nullptr;
+        }
+    }
+
+    void Callback::operator()(const std::string& channel) const
+    {
+        EdgeEvent event{};
+        event.channel = channel;
+        (*this)(event);
+    }
+
+    bool operator==(const Callback& A, const Callback& B)
+    {
+        if (A._ops != B._ops)
+            return false;
+        return A._ops == nullptr || A._ops->equal(A._buffer, B._buffer);
+    }
 
     bool operator!=(const Callback& A, const Callback& B) { return !(A == B); }
 } // namespace GPIO
@@ -0,0 +1,204 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/CallbackDispatcher.h"
+#include "private/MonotonicClock.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace GPIO
+{
+    void run_callbacks(const CallbackList& callbacks, const EdgeEvent& event, EventCounters* counters)
+    {
+        for (const auto& callback : callbacks)
+        {
+            uint64_t start_ns = counters ? (uint64_t)_monotonic_ns() : 0;
+            try
+            {
+                callback(event);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "[WARNING] Exception from a callback of channel " << event.channel << ": " << e.what()
+                          << std::endl;
+            }
+            if (counters)
+                counters->add_callback((uint64_t)_monotonic_ns() - start_ns);
+        }
+    }
+
+    CallbackDispatcher::~CallbackDispatcher() { _stop_workers(); }
+
+    bool CallbackDispatcher::post(int key, std::shared_ptr<const CallbackList> callbacks, const EdgeEvent& event,
+                                  std::shared_ptr<EventCounters> counters)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stats.queued >= _capacity)
+        {
+            _stats.dropped++;
+            return false;
+        }
+
+        KeyQueue& queue = _queues[key];
+        queue.events.push_back({std::move(callbacks), event, std::move(counters)});
+        _stats.queued++;
+        _stats.max_queued = std::max(_stats.max_queued, _stats.queued);
+
+        if (!queue.scheduled)
+        {
+            queue.scheduled = true;
+            _ready.push_back(key);
+            _cv.notify_one();
+        }
+
+        if (_workers.empty())
+            _start_workers();
+        return true;
+    }
+
+    void CallbackDispatcher::discard(int key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _queues.find(key);
+        if (it == _queues.end())
+            return;
+
+        // a scheduled key without events is skipped by the workers
+        _stats.queued -= it->second.events.size();
+        it->second.events.clear();
+    }
+
+    void CallbackDispatcher::wait_idle(int key)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle_cv.wait(lock,
+                      [this, key]
+                      {
+                          auto it = _queues.find(key);
+                          return it == _queues.end() || !it->second.running ||
+                                 it->second.runner == std::this_thread::get_id();
+                      });
+    }
+
+    void CallbackDispatcher::set_workers(size_t workers)
+    {
+        if (workers == 0)
+            throw std::runtime_error("There must be at least one callback worker");
+
+        _stop_workers();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _worker_count = workers;
+        if (_stats.queued > 0)
+            _start_workers();
+    }
+
+    void CallbackDispatcher::set_capacity(size_t capacity)
+    {
+        if (capacity == 0)
+            throw std::runtime_error("The callback queue size must be at least 1");
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+    }
+
+    CallbackStats CallbackDispatcher::stats() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _stats;
+    }
+
+    void CallbackDispatcher::_start_workers()
+    {
+        for (size_t i = 0; i < _worker_count; i++)
+            _workers.emplace_back(&CallbackDispatcher::_run, this);
+    }
+
+    void CallbackDispatcher::_stop_workers()
+    {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            _cv.notify_all();
+            workers.swap(_workers);
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = false;
+    }
+
+    void CallbackDispatcher::_run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _cv.wait(lock, [this] { return _stopping || !_ready.empty(); });
+            if (_stopping)
+                return;
+
+            int key = _ready.front();
+            _ready.pop_front();
+
+            KeyQueue& queue = _queues[key];
+            if (queue.events.empty())
+            {
+                // discarded
+                queue.scheduled = false;
+                continue;
+            }
+
+            auto queued = std::move(queue.events.front());
+            queue.events.pop_front();
+            _stats.queued--;
+
+            // the key stays scheduled while its callbacks run, so no other worker takes its next event
+            queue.running = true;
+            queue.runner = std::this_thread::get_id();
+            lock.unlock();
+            run_callbacks(*queued.callbacks, queued.event, queued.counters.get());
+            queued.callbacks = nullptr;
+            queued.counters = nullptr;
+            lock.lock();
+
+            _stats.dispatched++;
+            KeyQueue& next = _queues[key];
+            next.running = false;
+            _idle_cv.notify_all();
+            if (next.events.empty())
+            {
+                next.scheduled = false;
+            }
+            else
+            {
+                // behind the other keys that are waiting
+                _ready.push_back(key);
+                _cv.notify_one();
+            }
+        }
+    }
+} // namespace GPIO
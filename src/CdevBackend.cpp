@@ -0,0 +1,547 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/CdevBackend.h"
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "private/GPIOEvent.h"
+#include "private/PythonFunctions.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    constexpr auto CONSUMER = "JetsonGPIO";
+
+    int CdevIO::open(const char* path, int flags) { return ::open(path, flags); }
+
+    int CdevIO::ioctl(int fd, unsigned long request, void* arg) { return ::ioctl(fd, request, arg); }
+
+    ssize_t CdevIO::read(int fd, void* buf, size_t count) { return ::read(fd, buf, count); }
+
+    namespace
+    {
+        constexpr uint64_t EDGE_FLAGS = GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+        int _edge_flags(Edge edge)
+        {
+            switch (edge)
+            {
+            case Edge::RISING:
+                return GPIO_V2_LINE_FLAG_EDGE_RISING;
+            case Edge::FALLING:
+                return GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            case Edge::BOTH:
+                return GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            case Edge::NONE:
+                return 0;
+            default:
+                return -1;
+            }
+        }
+
+        // A request of one or more lines of the same chip. Index i of the vectors is the line with GPIOLine::index i.
+        struct CdevLineRequest : public LineRequest
+        {
+            std::string chip;
+            std::vector<unsigned> offsets;
+            std::vector<uint64_t> flags;
+            std::vector<uint32_t> debounce_us; // 0: not debounced by the kernel
+            std::vector<std::weak_ptr<GPIOLine>> lines;
+        };
+
+        CdevLineRequest& _cdev_request(const GPIOLine& line)
+        {
+            // released by cleanup()
+            if (line.request == nullptr)
+                throw runtime_error("You must setup() the GPIO channel first");
+            return static_cast<CdevLineRequest&>(*line.request);
+        }
+
+        /* Line configuration of a request. The most common flags are the default flags and the other flags are
+           attributes, followed by one attribute per debounce period. values: output values (bit i is the line with
+           index i) */
+        gpio_v2_line_config _line_config(const vector<uint64_t>& flags, const vector<uint32_t>& debounce_us,
+                                         uint64_t values)
+        {
+            gpio_v2_line_config config{};
+            if (flags.empty())
+                return config;
+
+            map<uint64_t, uint64_t> masks{};     // flags -> lines
+            map<uint32_t, uint64_t> debounces{}; // debounce period -> lines
+            uint64_t outputs = 0;
+            for (size_t i = 0; i < flags.size(); i++)
+            {
+                masks[flags[i]] |= 1ULL << i;
+                if (flags[i] & GPIO_V2_LINE_FLAG_OUTPUT)
+                    outputs |= 1ULL << i;
+                if (debounce_us[i])
+                    debounces[debounce_us[i]] |= 1ULL << i;
+            }
+
+            auto most_common = masks.begin();
+            for (auto it = masks.begin(); it != masks.end(); it++)
+            {
+                if (__builtin_popcountll(it->second) > __builtin_popcountll(most_common->second))
+                    most_common = it;
+            }
+            config.flags = most_common->first;
+
+            size_t max_flag_attrs = GPIO_V2_LINE_NUM_ATTRS_MAX - (outputs ? 1 : 0) - debounces.size();
+            if (masks.size() - 1 > max_flag_attrs)
+                throw runtime_error("Too many different line configurations in one request");
+
+            for (auto it = masks.begin(); it != masks.end(); it++)
+            {
+                if (it == most_common)
+                    continue;
+
+                auto& attr = config.attrs[config.num_attrs++];
+                attr.attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+                attr.attr.flags = it->first;
+                attr.mask = it->second;
+            }
+
+            if (outputs)
+            {
+                auto& attr = config.attrs[config.num_attrs++];
+                attr.attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+                attr.attr.values = values & outputs;
+                attr.mask = outputs;
+            }
+
+            for (const auto& debounce : debounces)
+            {
+                auto& attr = config.attrs[config.num_attrs++];
+                attr.attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+                attr.attr.debounce_period_us = debounce.first;
+                attr.mask = debounce.second;
+            }
+            return config;
+        }
+    } // namespace
+
+    struct CdevBackend::Line
+    {
+        shared_ptr<GPIOLine> line;
+        unsigned offset;
+        uint64_t flags;
+        int value;                // output value
+        uint32_t debounce_us = 0; // 0: not debounced by the kernel
+    };
+
+    CdevBackend::CdevBackend(shared_ptr<CdevIO> io) : _io(std::move(io)) {}
+
+    Backends CdevBackend::type() const { return Backends::CDEV; }
+
+    void CdevBackend::check_permission(const ChannelTable& table) const
+    {
+        set<string> chips{};
+        for (const auto& ch_info : table)
+        {
+            if (!is_None(ch_info.gpio_chip_cdev))
+                chips.insert(ch_info.gpio_chip_cdev);
+        }
+
+        for (const auto& chip : chips)
+        {
+            if (!os_access(chip, R_OK | W_OK))
+            {
+                cerr << "[ERROR] The current user does not have permissions set to access the library functionalites. "
+                        "Please configure permissions or use the root user to run this."
+                     << endl;
+                throw runtime_error("Permission Denied: " + chip);
+            }
+        }
+    }
+
+    int CdevBackend::_chip_fd(const string& chip)
+    {
+        auto& chip_fd = _chips[chip];
+        if (!chip_fd.is_open())
+        {
+            int fd = _io->open(chip.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0)
+                throw runtime_error("Can't open " + chip + ": " + strerror(errno));
+            chip_fd = FileDescriptor(fd);
+        }
+        return chip_fd.get();
+    }
+
+    Directions CdevBackend::direction(const ChannelInfo& ch_info)
+    {
+        if (is_None(ch_info.gpio_chip_cdev))
+            throw runtime_error("Can't find the GPIO character device of " + ch_info.gpio_chip_dir);
+
+        gpio_v2_line_info info{};
+        info.offset = ch_info.chip_gpio;
+        if (_io->ioctl(_chip_fd(ch_info.gpio_chip_cdev), GPIO_V2_GET_LINEINFO_IOCTL, &info) < 0)
+            throw runtime_error("Failed to get the line info of channel " + ch_info.channel + ": " + strerror(errno));
+
+        if (!(info.flags & GPIO_V2_LINE_FLAG_USED))
+            return Directions::UNKNOWN;
+        if (info.flags & GPIO_V2_LINE_FLAG_OUTPUT)
+            return Directions::OUT;
+        if (info.flags & GPIO_V2_LINE_FLAG_INPUT)
+            return Directions::IN;
+        return Directions::UNKNOWN;
+    }
+
+    void CdevBackend::_request_lines(const string& chip, const vector<Line>& lines)
+    {
+        if (lines.size() > GPIO_V2_LINES_MAX)
+            throw runtime_error("Too many lines in one request");
+
+        int chip_fd = _chip_fd(chip);
+
+        auto line_request = make_shared<CdevLineRequest>();
+        line_request->chip = chip;
+
+        gpio_v2_line_request request{};
+        uint64_t values = 0;
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            request.offsets[i] = lines[i].offset;
+            line_request->offsets.push_back(lines[i].offset);
+            line_request->flags.push_back(lines[i].flags);
+            line_request->debounce_us.push_back(lines[i].debounce_us);
+            line_request->lines.push_back(lines[i].line);
+            if (lines[i].value > 0)
+                values |= 1ULL << i;
+        }
+        request.num_lines = lines.size();
+        request.config = _line_config(line_request->flags, line_request->debounce_us, values);
+        strncpy(request.consumer, CONSUMER, sizeof(request.consumer) - 1);
+
+        if (_io->ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) < 0)
+            throw runtime_error("Failed to request GPIO lines of " + chip + ": " + strerror(errno));
+        line_request->fd = FileDescriptor(request.fd);
+
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            lines[i].line->request = line_request;
+            lines[i].line->index = i;
+        }
+    }
+
+    uint64_t CdevBackend::_get_values(const LineRequest& request, uint64_t mask)
+    {
+        gpio_v2_line_values values{};
+        values.mask = mask;
+        if (_io->ioctl(request.fd.get(), GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+            throw runtime_error(string("Failed to read the values of GPIO lines: ") + strerror(errno));
+        return values.bits & mask;
+    }
+
+    void CdevBackend::_set_config(const LineRequest& request)
+    {
+        const auto& cdev_request = static_cast<const CdevLineRequest&>(request);
+
+        // the output values are part of the configuration. keep the current ones.
+        size_t n = cdev_request.offsets.size();
+        gpio_v2_line_config config = _line_config(cdev_request.flags, cdev_request.debounce_us,
+                                                  _get_values(request, n < 64 ? (1ULL << n) - 1 : ~0ULL));
+        if (_io->ioctl(request.fd.get(), GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0)
+            throw runtime_error(strerror(errno));
+    }
+
+    vector<CdevBackend::Line> CdevBackend::_release_request(const LineRequest& request)
+    {
+        const auto& cdev_request = static_cast<const CdevLineRequest&>(request);
+        size_t n = cdev_request.offsets.size();
+        uint64_t values = _get_values(request, n < 64 ? (1ULL << n) - 1 : ~0ULL);
+
+        vector<Line> lines{};
+        for (size_t i = 0; i < n; i++)
+        {
+            auto line = cdev_request.lines[i].lock();
+            if (line == nullptr || line->request.get() != &request)
+                continue;
+            lines.push_back({line, cdev_request.offsets[i], cdev_request.flags[i], (int)((values >> i) & 1),
+                             cdev_request.debounce_us[i]});
+        }
+
+        // the request is closed when the last line lets it go
+        for (auto& line : lines)
+            line.line->request = nullptr;
+        return lines;
+    }
+
+    void CdevBackend::_isolate(const ChannelInfo& ch_info, bool keep)
+    {
+        auto& request = _cdev_request(*ch_info.line);
+        string chip = request.chip;
+
+        vector<Line> rest{};
+        vector<Line> alone{};
+        for (auto& line : _release_request(request))
+        {
+            if (line.line == ch_info.line)
+                alone.push_back(line);
+            else
+                rest.push_back(line);
+        }
+
+        if (!rest.empty())
+            _request_lines(chip, rest);
+        if (keep && !alone.empty())
+            _request_lines(chip, alone);
+    }
+
+    void CdevBackend::setup_out(const ChannelInfo& ch_info, int initial)
+    {
+        if (is_None(ch_info.gpio_chip_cdev))
+            throw runtime_error("Can't find the GPIO character device of " + ch_info.gpio_chip_dir);
+
+        int value = is_None(initial) ? 0 : (initial ? 1 : 0);
+        _request_lines(ch_info.gpio_chip_cdev,
+                       {{ch_info.line, (unsigned)ch_info.chip_gpio, GPIO_V2_LINE_FLAG_OUTPUT, value}});
+    }
+
+    void CdevBackend::setup_in(const ChannelInfo& ch_info)
+    {
+        if (is_None(ch_info.gpio_chip_cdev))
+            throw runtime_error("Can't find the GPIO character device of " + ch_info.gpio_chip_dir);
+
+        _request_lines(ch_info.gpio_chip_cdev, {{ch_info.line, (unsigned)ch_info.chip_gpio, GPIO_V2_LINE_FLAG_INPUT, 0}});
+    }
+
+    void CdevBackend::release(const ChannelInfo& ch_info)
+    {
+        const auto& request = ch_info.line->request;
+        if (request == nullptr)
+            return;
+
+        // the other lines of a merged request are requested again without this one
+        if (static_cast<const CdevLineRequest&>(*request).offsets.size() > 1)
+            _isolate(ch_info, false);
+        else
+            ch_info.line->request = nullptr;
+    }
+
+    void CdevBackend::write(const ChannelInfo& ch_info, int value)
+    {
+        const GPIOLine& line = *ch_info.line;
+        const auto& request = _cdev_request(line);
+        gpio_v2_line_values values{};
+        values.mask = 1ULL << line.index;
+        values.bits = value ? values.mask : 0;
+
+        if (_io->ioctl(request.fd.get(), GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0)
+            throw runtime_error("Failed to write the value of channel " + ch_info.channel + ": " + strerror(errno));
+    }
+
+    int CdevBackend::read(const ChannelInfo& ch_info)
+    {
+        const GPIOLine& line = *ch_info.line;
+        const auto& request = _cdev_request(line);
+        gpio_v2_line_values values{};
+        values.mask = 1ULL << line.index;
+
+        if (_io->ioctl(request.fd.get(), GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+            throw runtime_error("Failed to read the value of channel " + ch_info.channel + ": " + strerror(errno));
+        return (values.bits & values.mask) ? 1 : 0;
+    }
+
+    void CdevBackend::group(const vector<ChannelInfo>& ch_infos)
+    {
+        // chip -> requests to merge
+        map<string, vector<const LineRequest*>> chips{};
+        for (const auto& ch_info : ch_infos)
+        {
+            const GPIOLine& line = *ch_info.line;
+            const auto& request = _cdev_request(line);
+
+            // the events of a request can't be told apart yet. lines detecting edges keep their own request.
+            if (request.flags[line.index] & EDGE_FLAGS)
+                continue;
+
+            auto& requests = chips[request.chip];
+            if (find(requests.begin(), requests.end(), &request) == requests.end())
+                requests.push_back(&request);
+        }
+
+        for (const auto& chip : chips)
+        {
+            if (chip.second.size() < 2)
+                continue;
+
+            vector<Line> lines{};
+            for (const auto* request : chip.second)
+            {
+                auto released = _release_request(*request);
+                lines.insert(lines.end(), released.begin(), released.end());
+            }
+            _request_lines(chip.first, lines);
+        }
+    }
+
+    void CdevBackend::write_lines(const LineRequest& request, uint64_t mask, uint64_t bits)
+    {
+        gpio_v2_line_values values{};
+        values.mask = mask;
+        values.bits = bits & mask;
+
+        if (_io->ioctl(request.fd.get(), GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0)
+            throw runtime_error(string("Failed to write the values of GPIO lines: ") + strerror(errno));
+    }
+
+    uint64_t CdevBackend::read_lines(const LineRequest& request, uint64_t mask) { return _get_values(request, mask); }
+
+    int CdevBackend::set_edge(const ChannelInfo& ch_info, Edge edge)
+    {
+        int edge_flags = _edge_flags(edge);
+        if (edge_flags < 0)
+        {
+            cerr << format("Bad argument, edge=%i\n", (int)edge);
+            return (int)EventResultCode::IllegalEdgeArgument;
+        }
+
+        const GPIOLine& line = *ch_info.line;
+        if (line.request == nullptr)
+            return (int)EventResultCode::InternalTrackingError;
+
+        auto& request = static_cast<CdevLineRequest&>(*line.request);
+        request.flags[line.index] = GPIO_V2_LINE_FLAG_INPUT | edge_flags;
+
+        try
+        {
+            _set_config(request);
+        }
+        catch (exception& e)
+        {
+            cerr << "GPIO_V2_LINE_SET_CONFIG_IOCTL: " << e.what() << endl;
+            return (int)EventResultCode::CdevLine_EdgeConfig;
+        }
+        return 0;
+    }
+
+    bool CdevBackend::set_debounce(const ChannelInfo& ch_info, uint64_t period_us)
+    {
+        // the line may already be released by cleanup() when the event module turns the debounce off
+        const GPIOLine& line = *ch_info.line;
+        if (line.request == nullptr || period_us > UINT32_MAX)
+            return false;
+
+        auto& request = static_cast<CdevLineRequest&>(*line.request);
+        uint32_t previous = request.debounce_us[line.index];
+        request.debounce_us[line.index] = (uint32_t)period_us;
+
+        try
+        {
+            _set_config(request);
+            return true;
+        }
+        catch (exception& e)
+        {
+            request.debounce_us[line.index] = previous;
+            cerr << "GPIO_V2_LINE_SET_CONFIG_IOCTL (debounce): " << e.what() << endl;
+            return false;
+        }
+    }
+
+    int CdevBackend::open_edge(const ChannelInfo& ch_info, Edge edge, int& fd)
+    {
+        const auto& request = ch_info.line->request;
+        if (request == nullptr)
+            return (int)EventResultCode::InternalTrackingError;
+
+        // the edge file descriptor must not report the events of other lines
+        if (static_cast<const CdevLineRequest&>(*request).offsets.size() > 1)
+        {
+            try
+            {
+                _isolate(ch_info, true);
+            }
+            catch (exception& e)
+            {
+                cerr << "GPIO_V2_GET_LINE_IOCTL: " << e.what() << endl;
+                return (int)EventResultCode::CdevLine_EdgeConfig;
+            }
+        }
+
+        int result = set_edge(ch_info, edge);
+        if (result)
+            return result;
+
+        // The event module closes the file descriptor on its own schedule, so it gets a duplicate.
+        fd = fcntl(ch_info.line->request->fd.get(), F_DUPFD_CLOEXEC, 0);
+        if (fd == -1)
+        {
+            perror("fcntl(F_DUPFD_CLOEXEC)");
+            return (int)EventResultCode::CdevLine_EventFD;
+        }
+
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == -1)
+        {
+            perror("fcntl");
+            close(fd);
+            return (int)EventResultCode::CdevLine_EventFD;
+        }
+        return 0;
+    }
+
+    size_t CdevBackend::read_edges(int fd, EdgeRecord* records, size_t max)
+    {
+        // the kernel queues every edge with its direction and a CLOCK_MONOTONIC timestamp
+        gpio_v2_line_event events[16];
+        constexpr size_t chunk = sizeof(events) / sizeof(events[0]);
+
+        size_t count = 0;
+        while (count < max)
+        {
+            size_t wanted = std::min(max - count, chunk);
+            ssize_t size = _io->read(fd, events, wanted * sizeof(gpio_v2_line_event));
+            if (size <= 0)
+                break;
+
+            size_t n = size / sizeof(gpio_v2_line_event);
+            for (size_t i = 0; i < n; i++)
+            {
+                bool rising = events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE;
+                records[count++] = {rising ? Edge::RISING : Edge::FALLING, rising ? 1 : 0, events[i].timestamp_ns};
+            }
+
+            if (n < wanted)
+                break;
+        }
+        return count;
+    }
+
+    bool CdevBackend::initial_edge_event() const { return false; }
+
+} // namespace GPIO
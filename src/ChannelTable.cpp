@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/ChannelTable.h"
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace GPIO
+{
+    ChannelTable::ChannelTable(std::vector<ChannelInfo> channels) : _channels(std::move(channels))
+    {
+        for (size_t i = 0; i < _channels.size(); i++)
+        {
+            if (_channels[i].id != static_cast<int>(i))
+                throw std::runtime_error("[ChannelTable] channel id must be equal to its index");
+        }
+
+        _build_number_index();
+        _build_name_index();
+    }
+
+    const ChannelInfo* ChannelTable::find(int channel) const
+    {
+        if (channel < 0 || static_cast<size_t>(channel) >= _by_number.size())
+            return nullptr;
+
+        int id = _by_number[channel];
+        return id < 0 ? nullptr : &_channels[id];
+    }
+
+    const ChannelInfo* ChannelTable::find(const std::string& channel) const
+    {
+        if (_by_name.empty())
+            return nullptr;
+
+        int id = _by_name[_hash(channel, _seed) & (_by_name.size() - 1)];
+        if (id < 0 || _channels[id].channel != channel)
+            return nullptr;
+
+        return &_channels[id];
+    }
+
+    // FNV-1a, with the seed mixed into the offset basis
+    uint32_t ChannelTable::_hash(const std::string& s, uint32_t seed)
+    {
+        uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (unsigned char c : s)
+        {
+            h ^= c;
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    void ChannelTable::_build_number_index()
+    {
+        // only names in canonical decimal form (i.e. std::to_string(n) == name) are numbers
+        auto to_number = [](const std::string& s) -> int
+        {
+            auto is_digit = [](unsigned char c) { return std::isdigit(c) != 0; };
+            if (s.empty() || s.size() > 4 || !std::all_of(s.begin(), s.end(), is_digit))
+                return -1;
+
+            int n = std::stoi(s);
+            return std::to_string(n) == s ? n : -1;
+        };
+
+        for (const auto& ch_info : _channels)
+        {
+            int n = to_number(ch_info.channel);
+            if (n < 0)
+                continue;
+
+            if (static_cast<size_t>(n) >= _by_number.size())
+                _by_number.resize(n + 1, -1);
+
+            // keep the first one if a name is duplicated
+            if (_by_number[n] < 0)
+                _by_number[n] = ch_info.id;
+        }
+    }
+
+    void ChannelTable::_build_name_index()
+    {
+        // keep the first one if a name is duplicated
+        std::vector<int> ids{};
+        std::set<std::string> names{};
+        for (const auto& ch_info : _channels)
+        {
+            if (names.insert(ch_info.channel).second)
+                ids.push_back(ch_info.id);
+        }
+
+        if (ids.empty())
+            return;
+
+        // power of two, at least twice the number of names
+        size_t size = 1;
+        while (size < ids.size() * 2)
+            size <<= 1;
+
+        while (true)
+        {
+            for (uint32_t seed = 0; seed < 1000; seed++)
+            {
+                std::vector<int> slots(size, -1);
+                bool collision = false;
+
+                for (int id : ids)
+                {
+                    auto& slot = slots[_hash(_channels[id].channel, seed) & (size - 1)];
+                    if (slot >= 0)
+                    {
+                        collision = true;
+                        break;
+                    }
+                    slot = id;
+                }
+
+                if (!collision)
+                {
+                    _by_name = std::move(slots);
+                    _seed = seed;
+                    return;
+                }
+            }
+
+            size <<= 1;
+        }
+    }
+} // namespace GPIO
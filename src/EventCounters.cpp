@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/EventCounters.h"
+
+namespace GPIO
+{
+    namespace
+    {
+        size_t significant_bits(uint64_t value)
+        {
+            size_t bits = 0;
+            while (value)
+            {
+                bits++;
+                value >>= 1;
+            }
+            return bits;
+        }
+    } // namespace
+
+    constexpr size_t DurationHistogram::BUCKETS;
+
+    void DurationHistogram::add(uint64_t duration_ns)
+    {
+        _buckets[significant_bits(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t max = _max_ns.load(std::memory_order_relaxed);
+        while (duration_ns > max && !_max_ns.compare_exchange_weak(max, duration_ns, std::memory_order_relaxed))
+        {
+        }
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t DurationHistogram::percentile(double fraction) const
+    {
+        unsigned long long count = this->count();
+        uint64_t max = this->max();
+        if (count == 0)
+            return 0;
+
+        // the first bucket that reaches the rank, as its upper bound
+        unsigned long long rank = (unsigned long long)(fraction * count + 0.5);
+        if (rank == 0)
+            rank = 1;
+
+        unsigned long long seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++)
+        {
+            seen += _buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                uint64_t bound = i < 64 ? (uint64_t(1) << i) - 1 : UINT64_MAX;
+                return bound < max ? bound : max;
+            }
+        }
+        return max;
+    }
+
+    ChannelEventStats EventCounters::read() const
+    {
+        ChannelEventStats stats{};
+        stats.channel = _channel;
+        stats.edges = _edges.load(std::memory_order_relaxed);
+        stats.debounced = _debounced.load(std::memory_order_relaxed);
+        stats.glitches = _glitches.load(std::memory_order_relaxed);
+        stats.kernel_debounce = _kernel_debounce.load(std::memory_order_relaxed);
+
+        stats.callbacks = _callbacks.count();
+        stats.max_callback_ns = _callbacks.max();
+        stats.p50_callback_ns = _callbacks.percentile(0.50);
+        stats.p99_callback_ns = _callbacks.percentile(0.99);
+
+        stats.reflexes = _reflexes.count();
+        stats.reflex_errors = _reflex_errors.load(std::memory_order_relaxed);
+        stats.max_reflex_ns = _reflexes.max();
+        stats.p50_reflex_ns = _reflexes.percentile(0.50);
+        stats.p99_reflex_ns = _reflexes.percentile(0.99);
+        return stats;
+    }
+} // namespace GPIO
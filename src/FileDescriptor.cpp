@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <utility>
+
+namespace GPIO
+{
+    FileDescriptor::FileDescriptor(int fd) : _fd(fd) {}
+
+    FileDescriptor::FileDescriptor(FileDescriptor&& other) noexcept : _fd(other.release()) {}
+
+    FileDescriptor& FileDescriptor::operator=(FileDescriptor&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            _fd = other.release();
+        }
+        return *this;
+    }
+
+    FileDescriptor::~FileDescriptor() { close(); }
+
+    bool FileDescriptor::open(const std::string& path, int flags)
+    {
+        close();
+        _fd = ::open(path.c_str(), flags | O_CLOEXEC);
+        return _fd >= 0;
+    }
+
+    void FileDescriptor::close()
+    {
+        if (_fd < 0)
+            return;
+
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    int FileDescriptor::release() { return std::exchange(_fd, -1); }
+
+    bool FileDescriptor::write_char(char c) const
+    {
+        ssize_t result{};
+        do
+        {
+            result = ::pwrite(_fd, &c, 1, 0);
+        } while (result < 0 && errno == EINTR);
+
+        return result == 1;
+    }
+
+    int FileDescriptor::read_char() const
+    {
+        char c{};
+        ssize_t result{};
+        do
+        {
+            result = ::pread(_fd, &c, 1, 0);
+        } while (result < 0 && errno == EINTR);
+
+        return result == 1 ? static_cast<unsigned char>(c) : -1;
+    }
+} // namespace GPIO
@@ -24,14 +24,24 @@ DEALINGS IN THE SOFTWARE.
 */
 
 #include "private/GPIOEvent.h"
+#include "private/CallbackDispatcher.h"
+#include "private/EventCounters.h"
+#include "private/EventRing.h"
+#include "private/FileDescriptor.h"
+#include "private/MonotonicClock.h"
+#include "private/PulseCounter.h"
 #include "private/PythonFunctions.h"
-#include "private/SysfsRoot.h"
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
@@ -41,11 +51,13 @@ DEALINGS IN THE SOFTWARE.
 #include <map>
 #include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 #include <memory>
 
 
 constexpr size_t MAX_EPOLL_EVENTS = 20;
+constexpr size_t MAX_EDGE_RECORDS = 16;
 
 namespace GPIO
 {
@@ -69,6 +81,22 @@ namespace GPIO
         {EventResultCode::EpollWait, "Error occurred during call to epoll_wait"},
         {EventResultCode::GPIO_Event_Not_Found,
          "A channel event was not added to add a callback to. Call add_event_detect() first"},
+        {EventResultCode::CdevLine_EdgeConfig, "Failure to configure the edge detection of the GPIO line request"},
+        {EventResultCode::CdevLine_EventFD, "Failure to duplicate the GPIO line request file descriptor"},
+        {EventResultCode::EpollWakeFD_CreateError, "Failed to create the eventfd to wake up the Epoll Thread"},
+        {EventResultCode::EdgeSinkConflict,
+         "A channel can either detect events or be measured (pulse counter, pulse capture, encoder), not both"},
+        {EventResultCode::EventThreadRunning,
+         "The event thread is already running. Call event_fd() before any event detection"},
+        {EventResultCode::EventLoopNotEmbedded, "Call event_fd() to use the embedded event loop first"},
+    };
+
+    // An output written by the event thread when the input detects an edge (_add_reflex())
+    struct _Reflex
+    {
+        Edge edge;          // RISING, FALLING or BOTH
+        std::shared_ptr<ChannelInfo> output; // resolved when the reflex is added: written without a lookup
+        int value;                           // 0 or 1, -1 toggles the output
     };
 
     struct _gpioEventObject
@@ -86,305 +114,747 @@ namespace GPIO
         std::string channel_id;
         int gpio;
         int fd;
+        std::shared_ptr<Backend> backend;
         Edge edge;
-        uint64_t bounce_time;
-        uint64_t last_event;
+        uint64_t bounce_time;   // milliseconds
+        uint64_t last_event_ns; // CLOCK_MONOTONIC time of the last edge that passed the bounce time filter
+        uint64_t seqno;         // number of edges reported
+
+        // set while the backend debounces the line (_set_bounce_time()): the bounce time isn't checked again
+        std::shared_ptr<ChannelInfo> debounce_channel;
 
         bool event_occurred;
 
         bool blocking_usage, concurrent_usage;
-        std::vector<Callback> callbacks;
+
+        // the fd is in the epoll set of the event thread (added by the ADD change)
+        bool in_epoll = false;
+
+        // copied on change: the callback workers use the set that was current when the event was detected
+        std::shared_ptr<const CallbackList> callbacks;
+
+        // filled by the epoll thread when set with _set_event_buffer()
+        std::shared_ptr<EventRing> event_buffer;
+
+        // set by _add_edge_sink(): the edges are given to it, no events are made
+        std::shared_ptr<EdgeSink> sink;
+
+        // kept in _event_counters while the object is in _gpio_events
+        std::shared_ptr<EventCounters> counters;
+
+        // glitch filter (_set_glitch_filter()): an edge is held until its level has held for glitch_window_ns
+        uint64_t glitch_window_ns = 0;
+        std::shared_ptr<ChannelInfo> glitch_channel; // to sample the level
+        int stable_level = -1;                       // level after the last edge delivered
+        bool glitch_pending = false;                 // pending_edge is held, in _glitch_pending
+        EdgeRecord pending_edge{};                   // with its timestamp and level
+        uint64_t pending_deadline_ns = 0;
+
+        // applied to each event before it is fired
+        std::vector<_Reflex> reflexes;
+
+        // the first event delivered during a blocking wait, reported by the wait
+        bool waiter_fired = false;
+        EdgeEvent waiter_event{};
     };
 
+    /* The event buffers and pulse counters by gpio, for the readers. They have their own mutex so that a reader
+       never waits for the epoll thread, which holds _epmutex while it handles the edges. */
+    std::mutex _readers_mutex;
+    std::map<int, std::shared_ptr<EventRing>> _event_buffers;
+    std::map<int, std::shared_ptr<PulseCounter>> _pulse_counters;
+    std::map<int, std::shared_ptr<EventCounters>> _event_counters;
+
+    // passes of the event loop, and the passes that had more ready fds than MAX_EPOLL_EVENTS
+    std::atomic<unsigned long long> _epoll_wakeups{0};
+    std::atomic<unsigned long long> _epoll_full_batches{0};
+
+    // declared before the thread so that it outlives it
+    CallbackDispatcher _callback_dispatcher;
+
     std::recursive_mutex _epmutex;
     std::unique_ptr<std::thread> _epoll_fd_thread = nullptr;
     std::atomic_bool _epoll_run_loop;
 
+    // eventfd in the epoll set of the thread. written to wake the thread up when there are changes to apply.
+    int _epoll_wake_fd = -1;
+
+    // Embedded event loop (_event_fd()): set instead of the thread, processed by _process_events()
+    int _embedded_epoll_fd = -1;
+
+    // epoll set of the running thread, or -1. Used with _epmutex held.
+    int _epoll_thread_fd = -1;
+
+    // A detected event and the callbacks to call with it
+    struct _PendingCallbacks
+    {
+        std::shared_ptr<const CallbackList> callbacks;
+        EdgeEvent event;
+        std::shared_ptr<EventCounters> counters;
+    };
+
+    // The edges read in one pass of the event loop, fired in the order of their timestamps. Used with _epmutex held.
+    std::vector<std::pair<_gpioEventObject*, EdgeRecord>> _edge_batch;
+
     std::map<int, std::shared_ptr<_gpioEventObject>> _gpio_events;
     std::atomic_int _auth_event_channel_count(0);
-    std::map<int, int> _fd_to_gpio_map;
+
+    /* The gpio of the objects in the epoll set whose blocking wait has ended. The event thread didn't read their fds
+       during the wait, and isn't notified again of the edges left in them. Used with _epmutex held. */
+    std::vector<int> _epoll_drain_pending;
+
+    // some objects wait in INITIAL_ABSCOND for their first edge: the changes are applied on every pass until then
+    bool _epoll_abscond_pending = false;
+
+    // The objects holding an edge for their glitch filter, and the timerfd in the epoll set that fires at the first
+    // deadline. Used with _epmutex held.
+    std::vector<_gpioEventObject*> _glitch_pending;
+    int _glitch_timer_fd = -1;
+    uint64_t _glitch_timer_armed_ns = 0; // 0 if disarmed
+    int _glitch_timer_tag = 0;           // its address is the epoll data of the timerfd
 
     //----------------------------------
 
-    int _write_sysfs_edge(const std::string gpio_name, Edge edge, bool allow_none = true)
+    // Give geo its counters, readable by _event_stats() until _erase_counters()
+    void _register_counters(_gpioEventObject& geo)
     {
-        auto buf = format("%s/%s/edge", _SYSFS_ROOT, gpio_name.c_str());
+        geo.counters = std::make_shared<EventCounters>(geo.channel_id);
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        _event_counters[geo.gpio] = geo.counters;
+    }
 
-        int edge_fd = open(buf.c_str(), O_WRONLY);
-        if (edge_fd == -1)
+    void _erase_counters(int gpio)
+    {
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        _event_counters.erase(gpio);
+    }
+
+    /* Set the bounce time of a channel. The backend debounces its line if it can, so that the bounces never wake the
+       event thread. Otherwise _passes_bounce_time() filters the edges. geo must have its counters. */
+    void _set_bounce_time(_gpioEventObject& geo, const ChannelInfo& ch_info, uint64_t bounce_time)
+    {
+        if (bounce_time == geo.bounce_time)
+            return;
+
+        geo.bounce_time = bounce_time;
+        bool kernel = bounce_time && geo.backend->set_debounce(ch_info, bounce_time * 1000);
+        if (!kernel && geo.debounce_channel)
+            geo.backend->set_debounce(*geo.debounce_channel, 0);
+
+        geo.debounce_channel = kernel ? std::make_shared<ChannelInfo>(ch_info) : nullptr;
+        geo.counters->set_kernel_debounce(kernel);
+    }
+
+    // the line is debounced for the edge detection only
+    void _clear_kernel_debounce(_gpioEventObject& geo)
+    {
+        if (geo.debounce_channel == nullptr)
+            return;
+
+        geo.backend->set_debounce(*geo.debounce_channel, 0);
+        geo.debounce_channel = nullptr;
+    }
+
+    void _drop_pending_edge(_gpioEventObject& geo)
+    {
+        if (!geo.glitch_pending)
+            return;
+
+        geo.glitch_pending = false;
+        _glitch_pending.erase(std::find(_glitch_pending.begin(), _glitch_pending.end(), &geo));
+    }
+
+    /* Remove the fd of geo from the epoll set and close it. A cdev edge fd shares the line request, which stays busy
+       until it is closed. */
+    void _close_edge_fd(int epoll_fd, _gpioEventObject& geo)
+    {
+        if (geo.fd == -1)
+            return;
+
+        // Before the close: the request fd keeps the shared file open, and with it the entry in the epoll set
+        if (geo.in_epoll && epoll_fd != -1 && epoll_ctl(epoll_fd, EPOLL_CTL_DEL, geo.fd, 0) == -1)
         {
-            // I/O Error
-            std::perror("sysfs/edge open");
-            return (int)GPIO::EventResultCode::SysFD_EdgeOpen;
+            // Okay to ignore I believe. File will be closed just below anyways.
         }
+        geo.in_epoll = false;
 
-        auto get_result = [=]() -> int
+        // Close the fd
+        if (close(geo.fd) == -1)
         {
-            switch (edge)
-            {
-            case Edge::RISING:
-                return write(edge_fd, "rising", 7);
-            case Edge::FALLING:
-                return write(edge_fd, "falling", 7);
-            case Edge::BOTH:
-                return write(edge_fd, "both", 7);
-            case Edge::NONE:
-            {
-                if (!allow_none)
-                {
-                    return (int)GPIO::EventResultCode::UnallowedEdgeNone;
-                }
-                return write(edge_fd, "none", 7);
-            }
-            case Edge::UNKNOWN:
+            std::cerr << "[WARNING] Failed to close Epoll_Thread file descriptor\n";
+        }
+        geo.fd = -1;
+    }
 
-            default:
-                std::cerr << format("Bad argument, edge=%i\n", (int)edge);
-                return (int)GPIO::EventResultCode::IllegalEdgeArgument;
-            }
-        };
+    std::map<int, std::shared_ptr<_gpioEventObject>>::iterator
+    _epoll_thread_remove_event(int epoll_fd, std::map<int, std::shared_ptr<_gpioEventObject>>::iterator geo_it)
+    {
+        auto geo = geo_it->second;
+        _close_edge_fd(epoll_fd, *geo);
+
+        // Erase from the map collection
+        _drop_pending_edge(*geo);
+        _clear_kernel_debounce(*geo);
+        _erase_counters(geo->gpio);
+        return _gpio_events.erase(geo_it);
+    }
 
-        int result = get_result();
+    void _epoll_wake_thread()
+    {
+        if (_epoll_wake_fd == -1)
+            return;
 
-        if (result >= 0)
-            result = 0;
-        else if (result == -1)
+        uint64_t one = 1;
+        if (::write(_epoll_wake_fd, &one, sizeof(one)) == -1 && errno != EAGAIN)
         {
-            // Print additional detail and label as a edge write error
-            std::perror("sysfs/edge write");
-            result = (int)GPIO::EventResultCode::SysFD_EdgeWrite;
+            std::perror("[WARNING] Failed to wake up the concurrent Epoll Thread");
         }
+    }
 
-        close(edge_fd);
-        return result;
+    // The edge of a record, from the edge detected or the level after the edge if the backend doesn't tell it
+    Edge _record_edge(const _gpioEventObject& geo, const EdgeRecord& record)
+    {
+        if (record.edge != Edge::UNKNOWN)
+            return record.edge;
+        if (geo.edge != Edge::BOTH)
+            return geo.edge;
+        if (record.level != -1)
+            return record.level ? Edge::RISING : Edge::FALLING;
+        return Edge::UNKNOWN;
     }
 
-    int _open_sysfd_value(const std::string& gpio_name, int& fd)
+    /* Returns false if the edge is filtered out by the bounce time, which is counted. Checked as soon as the edge is
+       read, before the glitch filter holds it. */
+    bool _passes_bounce_time(_gpioEventObject& geo, const EdgeRecord& record, uint64_t wake_ns)
     {
-        auto buf = format("%s/%s/value", _SYSFS_ROOT, gpio_name.c_str());
-        fd = open(buf.c_str(), O_RDONLY);
+        // The kernel has already dropped the bounces of a debounced line
+        if (!geo.bounce_time || geo.debounce_channel)
+            return true;
 
-        if (fd == -1)
+        uint64_t timestamp_ns = record.timestamp_ns ? record.timestamp_ns : wake_ns;
+        if (timestamp_ns - geo.last_event_ns < geo.bounce_time * 1000000)
         {
-            std::perror("sysfs/value open");
-            return (int)GPIO::EventResultCode::SysFD_ValueOpen;
+            geo.counters->add_debounced();
+            return false;
         }
 
-        // Set the file descriptor to a non-blocking usage
-        int result = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
-        if (result == -1)
+        geo.last_event_ns = timestamp_ns;
+        return true;
+    }
+
+    // Fill the event of an edge that passed the filters
+    void _make_edge_event(_gpioEventObject& geo, const EdgeRecord& record, uint64_t wake_ns, EdgeEvent& event)
+    {
+        uint64_t timestamp_ns = record.timestamp_ns ? record.timestamp_ns : wake_ns;
+
+        event.channel = geo.channel_id;
+        event.edge = _record_edge(geo, record);
+        event.level = record.level;
+        event.timestamp_ns = timestamp_ns;
+        event.seqno = ++geo.seqno;
+    }
+
+    // Write the outputs of the reflexes of geo matching the edge of event. Never throws: a failed write is counted.
+    void _fire_reflexes(_gpioEventObject& geo, const EdgeEvent& event)
+    {
+        for (const auto& reflex : geo.reflexes)
         {
-            std::perror("fcntl");
-            close(fd);
-            return (int)GPIO::EventResultCode::SysFD_ValueNonBlocking;
+            if (reflex.edge != Edge::BOTH && reflex.edge != event.edge)
+                continue;
+
+            try
+            {
+                int value = reflex.value < 0 ? !geo.backend->read(*reflex.output) : reflex.value;
+                geo.backend->write(*reflex.output, value);
+
+                uint64_t now_ns = _monotonic_ns();
+                geo.counters->add_reflex(now_ns > event.timestamp_ns ? now_ns - event.timestamp_ns : 0);
+            }
+            catch (std::exception& e)
+            {
+                geo.counters->add_reflex_error();
+            }
         }
+    }
 
-        return 0;
+    // Make the event of an edge that passed the filters and fire it
+    void _deliver_edge(_gpioEventObject& geo, const EdgeRecord& record, uint64_t wake_ns,
+                       std::vector<_PendingCallbacks>* inline_calls)
+    {
+        EdgeEvent event{};
+        _make_edge_event(geo, record, wake_ns, event);
+        if (geo.blocking_usage && !geo.waiter_fired)
+        {
+            geo.waiter_event = event;
+            geo.waiter_fired = true;
+        }
+
+        // before anything else, so that the reaction doesn't wait for the callbacks
+        if (!geo.reflexes.empty())
+        {
+            _fire_reflexes(geo, event);
+        }
+
+        // Fire event. The callbacks are run by the callback workers (or after _process_events() releases _epmutex).
+        geo.event_occurred = true;
+        if (geo.event_buffer)
+        {
+            geo.event_buffer->push(event);
+        }
+        if (!geo.callbacks->empty())
+        {
+            if (inline_calls)
+                inline_calls->push_back({geo.callbacks, event, geo.counters});
+            else
+                _callback_dispatcher.post(geo.gpio, geo.callbacks, event, geo.counters);
+        }
     }
 
-    std::map<int, std::shared_ptr<_gpioEventObject>>::iterator
-    _epoll_thread_remove_event(int epoll_fd, std::map<int, std::shared_ptr<_gpioEventObject>>::iterator geo_it)
+    /* End the hold of the pending edge of geo. level: the level of the channel now. The edge is delivered if the
+       channel is still at its level, and (when detecting both edges) it is not back to the level before it. */
+    void _settle_pending_edge(_gpioEventObject& geo, int level, std::vector<_PendingCallbacks>* inline_calls)
     {
-        auto geo = geo_it->second;
+        EdgeRecord record = geo.pending_edge;
+        _drop_pending_edge(geo);
+
+        if (record.level == -1)
+            record.level = level;
 
-        if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, geo->fd, 0) == -1)
+        if (level != record.level || (geo.edge == Edge::BOTH && level == geo.stable_level))
         {
-            // Okay to ignore I believe. File will be closed just below anyways.
+            geo.counters->add_glitch();
+            return;
         }
 
-        auto fg_it = _fd_to_gpio_map.find(geo->fd);
-        if (fg_it != _fd_to_gpio_map.end())
-            _fd_to_gpio_map.erase(fg_it);
+        geo.stable_level = level;
+        _deliver_edge(geo, record, record.timestamp_ns, inline_calls);
+    }
 
-        // Close the fd
-        if (close(geo->fd) == -1)
+    // Hold an edge of a channel with a glitch filter, until the window has passed without another edge
+    void _hold_edge(_gpioEventObject& geo, const EdgeRecord& record, uint64_t wake_ns,
+                    std::vector<_PendingCallbacks>* inline_calls)
+    {
+        const uint64_t timestamp_ns = record.timestamp_ns ? record.timestamp_ns : wake_ns;
+        if (geo.glitch_pending)
         {
-            std::cerr << "[WARNING] Failed to close Epoll_Thread file descriptor\n";
+            if (timestamp_ns >= geo.pending_deadline_ns)
+            {
+                // the pending edge held for the window (the pass is late): its level is the one before this edge
+                _settle_pending_edge(geo, geo.pending_edge.level, inline_calls);
+            }
+            else
+            {
+                // the level changed again within the window
+                geo.counters->add_glitch();
+                _drop_pending_edge(geo);
+            }
         }
 
-        // Erase from the map collection
-        return _gpio_events.erase(geo_it);
+        geo.pending_edge = record;
+        geo.pending_edge.timestamp_ns = timestamp_ns;
+        if (record.level == -1)
+        {
+            Edge edge = _record_edge(geo, record);
+            if (edge != Edge::UNKNOWN)
+                geo.pending_edge.level = edge == Edge::RISING ? 1 : 0;
+        }
+        geo.pending_deadline_ns = timestamp_ns + geo.glitch_window_ns;
+        geo.glitch_pending = true;
+        _glitch_pending.push_back(&geo);
     }
 
-    void _epoll_thread_loop()
+    // Settle the pending edges whose window has passed, and arm the timer for the next deadline
+    void _settle_pending_edges(std::vector<_PendingCallbacks>* inline_calls)
     {
-        int epoll_fd = epoll_create1(0);
-        if (epoll_fd == -1)
+        const uint64_t now_ns = _monotonic_ns();
+        uint64_t next_deadline_ns = 0;
+        for (size_t i = 0; i < _glitch_pending.size();)
         {
-            std::perror("[Fatal Error] Failed to create epoll file descriptor for concurrent Epoll Thread\n");
+            _gpioEventObject& geo = *_glitch_pending[i];
+            if (geo.pending_deadline_ns > now_ns)
+            {
+                if (next_deadline_ns == 0 || geo.pending_deadline_ns < next_deadline_ns)
+                    next_deadline_ns = geo.pending_deadline_ns;
+                i++;
+                continue;
+            }
+
+            // Re-sample: the edge stands if the channel is still at its level
+            int level = geo.pending_edge.level;
+            try
+            {
+                level = geo.backend->read(*geo.glitch_channel);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "[WARNING] " << e.what() << std::endl;
+            }
+            _settle_pending_edge(geo, level, inline_calls); // removes it from _glitch_pending
+        }
+
+        if (next_deadline_ns == _glitch_timer_armed_ns || _glitch_timer_fd == -1)
+            return;
+
+        itimerspec timer{};
+        timer.it_value.tv_sec = next_deadline_ns / 1000000000;
+        timer.it_value.tv_nsec = next_deadline_ns % 1000000000;
+        if (timerfd_settime(_glitch_timer_fd, TFD_TIMER_ABSTIME, &timer, nullptr) == -1)
+        {
+            std::perror("[WARNING] Failed to set the glitch filter timer");
             return;
         }
+        _glitch_timer_armed_ns = next_deadline_ns;
+    }
 
-        auto cleanup_and_return = [&epoll_fd]()
+    void _epoll_thread_fire_event(_gpioEventObject& geo, const EdgeRecord& record, uint64_t wake_ns,
+                                  std::vector<_PendingCallbacks>* inline_calls)
+    {
+        geo.counters->add_edge();
+        if (geo.sink)
         {
-            // Cleanup - thread is ending
-            // -- GPIO Event Objects
+            uint64_t timestamp_ns = record.timestamp_ns ? record.timestamp_ns : wake_ns;
+            geo.sink->on_edge(geo.gpio, _record_edge(geo, record), record.level, timestamp_ns);
+            return;
+        }
+
+        // an edge dropped by the bounce time is not a glitch
+        if (!_passes_bounce_time(geo, record, wake_ns))
+            return;
+
+        if (geo.glitch_window_ns)
+        {
+            _hold_edge(geo, record, wake_ns, inline_calls);
+            return;
+        }
+
+        _deliver_edge(geo, record, wake_ns, inline_calls);
+    }
+
+    // Read the edges of geo for the current pass of the event loop. Returns the number of edges added to _edge_batch.
+    size_t _epoll_thread_read_edges(_gpioEventObject& geo)
+    {
+        EdgeRecord records[MAX_EDGE_RECORDS];
+        size_t record_count = 0;
+        const size_t edges_before = _edge_batch.size();
+        do
+        {
+            record_count = geo.backend->read_edges(geo.fd, records, MAX_EDGE_RECORDS);
+
+            if (geo._epoll_change_flag != _gpioEventObject::ModifyEvent::NONE)
             {
-                std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
-                for (auto geo_it = _gpio_events.begin(); geo_it != _gpio_events.end();)
-                {
-                    geo_it = _epoll_thread_remove_event(epoll_fd, geo_it);
-                }
+                // To be dealt with later. No events should be fired in this case
+                continue;
             }
 
-            // epoll
-            if (close(epoll_fd) == -1)
+            for (size_t r = 0; r < record_count; r++)
             {
-                std::perror(
-                    "[WARNING] Failed to close epoll file descriptor during closure of concurrent Epoll_Thread\n");
+                _edge_batch.emplace_back(&geo, records[r]);
             }
-        };
+        } while (record_count == MAX_EDGE_RECORDS);
 
+        return _edge_batch.size() - edges_before;
+    }
+
+    /* One pass of the event loop: handles the edges that are ready, then applies the changes queued by
+       _epoll_wake_thread(). timeout_ms as in epoll_wait(). Returns the number of edges handled, or -1 on a fatal
+       error. The callbacks are posted to the callback workers, or added to inline_calls if it is not null. */
+    int _epoll_process(int epoll_fd, int timeout_ms, std::vector<_PendingCallbacks>* inline_calls)
+    {
+        // Wait for an edge or a change queued by _epoll_wake_thread()
         epoll_event events[MAX_EPOLL_EVENTS]{};
-        while (_epoll_run_loop)
+        int event_count = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENTS, timeout_ms);
+
+        // The time of the edges for the backends that don't record it
+        const uint64_t wake_ns = _monotonic_ns();
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+        _edge_batch.clear();
+        bool woken = false;
+
+        _epoll_wakeups.fetch_add(1, std::memory_order_relaxed);
+        if (event_count == MAX_EPOLL_EVENTS)
         {
-            // Wait a small time for events
-            int event_count = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENTS, 1);
-            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            // the other ready fds wait for the next pass
+            _epoll_full_batches.fetch_add(1, std::memory_order_relaxed);
+        }
 
-            // Handle Events
-            if (event_count)
+        // Handle Events
+        if (event_count)
+        {
+            if (event_count < 0)
             {
-                if (event_count < 0)
+                if (errno != EINTR)
                 {
-                    if (errno != EINTR)
-                    {
-                        std::perror("[Fatal Error] epoll_wait");
-                        return cleanup_and_return();
-                    }
-                    break;
+                    std::perror("[Fatal Error] epoll_wait");
+                    return -1;
                 }
+                return 0;
+            }
 
-                // Handle event modifications
-                auto tick = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
-                                std::chrono::system_clock::now().time_since_epoch())
-                                .count();
+            int edge_sources = 0;
 
-                // Iterate through each collected event
-                for (int e = 0; e < event_count; e++)
+            // Iterate through each collected event
+            for (int e = 0; e < event_count; e++)
+            {
+                /* The event object itself (nullptr for the wake-up eventfd). It stays in _gpio_events until this
+                   function handles its removal, so the pointer is valid. Its fd may have been closed since. */
+                if (events[e].data.ptr == &_glitch_timer_tag)
                 {
-                    // Obtain the event object for the event
-                    auto gpio_it = _fd_to_gpio_map.find(events[e].data.fd);
-                    if (gpio_it == _fd_to_gpio_map.end())
+                    // Reset the timer. The pending edges are settled below.
+                    uint64_t expirations = 0;
+                    if (::read(_glitch_timer_fd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
                     {
-                        // Shouldn't happen - ignore it if it does
-                        continue;
+                        std::perror("[WARNING] Failed to read the glitch filter timer");
                     }
+                    _glitch_timer_armed_ns = 0;
+                    continue;
+                }
 
-                    auto geo_it = _gpio_events.find(gpio_it->second);
-                    if (geo_it == _gpio_events.end())
+                auto geo = static_cast<_gpioEventObject*>(events[e].data.ptr);
+                if (!geo)
+                {
+                    // Reset the counter. The changes are applied below.
+                    uint64_t count = 0;
+                    if (::read(_epoll_wake_fd, &count, sizeof(count)) == -1 && errno != EAGAIN)
                     {
-                        // Shouldn't happen
-                        // If it does -- ensure the fd is deleted & ignore any errors
-                        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, events[e].data.fd, 0);
-
-                        // Remove the item from the map
-                        _fd_to_gpio_map.erase(gpio_it);
-                        continue;
+                        std::perror("[WARNING] Failed to read the wake-up eventfd of the concurrent Epoll Thread");
                     }
+                    woken = true;
+                    continue;
+                }
 
-                    if (geo_it->second->_epoll_change_flag != _gpioEventObject::ModifyEvent::NONE)
-                    {
-                        // To be dealt with later. No events should be fired in this case
-                        continue;
-                    }
+                if (geo->blocking_usage)
+                {
+                    // The blocking wait reads the fd and fires the edges (_blocking_wait_for_edges())
+                    continue;
+                }
+                if (geo->fd == -1)
+                {
+                    // Closed by _remove_edge_detect_locked() after epoll_wait() returned
+                    continue;
+                }
 
-                    // Event & GPIO
-                    auto geo = geo_it->second;
+                if (_epoll_thread_read_edges(*geo))
+                    edge_sources++;
+            }
 
-                    // Check event filter conditions
-                    if (geo->bounce_time)
-                    {
-                        if (tick - geo->last_event < geo->bounce_time)
-                        {
-                            continue;
-                        }
+            // The edges left in the fds of the blocking waits that have ended (_release_blocking_usage())
+            for (int gpio : _epoll_drain_pending)
+            {
+                auto find_result = _gpio_events.find(gpio);
+                if (find_result == _gpio_events.end() || find_result->second->blocking_usage)
+                    continue;
 
-                        geo->last_event = tick;
-                    }
+                /* Only if an edge is pending: a sysfs value fd always reads as one edge. It is always readable, and
+                   tells an edge with POLLPRI (the backends reporting an initial edge). */
+                auto& geo = *find_result->second;
+                pollfd pending{geo.fd, (short)(geo.backend->initial_edge_event() ? POLLPRI : POLLIN), 0};
+                if (poll(&pending, 1, 0) != 1 || !(pending.revents & pending.events))
+                    continue;
 
-                    // Fire event
-                    geo->event_occurred = true;
-                    for (auto& cb : geo->callbacks)
-                    {
-                        cb(geo->channel_id);
-                    }
-                }
+                if (_epoll_thread_read_edges(geo))
+                    edge_sources++;
             }
+            _epoll_drain_pending.clear();
 
-            // Handle changes/modifications to GPIO event objects
-            for (auto geo_it = _gpio_events.begin(); geo_it != _gpio_events.end();)
+            /* The edges of each file descriptor are in order, but the file descriptors are read one after the
+               other: merge them so that a sink of several channels (e.g. QuadratureEncoder) sees the edges as they
+               happened. The records without a timestamp keep the order they were read in. */
+            if (edge_sources > 1)
             {
-                auto geo = geo_it->second;
-                switch (geo->_epoll_change_flag)
-                {
-                case _gpioEventObject::ModifyEvent::NONE:
+                std::stable_sort(_edge_batch.begin(), _edge_batch.end(),
+                                 [wake_ns](const std::pair<_gpioEventObject*, EdgeRecord>& a,
+                                           const std::pair<_gpioEventObject*, EdgeRecord>& b)
+                                 {
+                                     uint64_t a_ns = a.second.timestamp_ns ? a.second.timestamp_ns : wake_ns;
+                                     uint64_t b_ns = b.second.timestamp_ns ? b.second.timestamp_ns : wake_ns;
+                                     return a_ns < b_ns;
+                                 });
+            }
+
+            for (const auto& edge : _edge_batch)
+            {
+                _epoll_thread_fire_event(*edge.first, edge.second, wake_ns, inline_calls);
+            }
+        }
+
+        if (!_glitch_pending.empty())
+        {
+            _settle_pending_edges(inline_calls);
+        }
+
+        /* Handle changes/modifications to GPIO event objects. They are always followed by _epoll_wake_thread(), so
+           the passes that only handle edges don't have to look at every object. */
+        if (!woken && !_epoll_abscond_pending)
+            return (int)_edge_batch.size();
+
+        _epoll_abscond_pending = false;
+        for (auto geo_it = _gpio_events.begin(); geo_it != _gpio_events.end();)
+        {
+            auto geo = geo_it->second;
+            switch (geo->_epoll_change_flag)
+            {
+            case _gpioEventObject::ModifyEvent::NONE:
+            {
+                // No change
+            }
+            break;
+            case _gpioEventObject::ModifyEvent::INITIAL_ABSCOND:
+            {
+                geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::NONE;
+            }
+            break;
+            case _gpioEventObject::ModifyEvent::MODIFY:
+            {
+                // For now this just means modification of the edge type, which is done on the calling thread
+                // Just set back to NONE and continue
+                geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::NONE;
+            }
+            break;
+            case _gpioEventObject::ModifyEvent::ADD:
+            {
+                if (geo->blocking_usage)
                 {
-                    // No change
+                    /* Not while a blocking wait reads the fd: the thread would take its edges. Added when the wait
+                       ends. */
+                    break;
                 }
-                break;
-                case _gpioEventObject::ModifyEvent::INITIAL_ABSCOND:
+
+                geo->_epoll_event.events = EPOLLIN | EPOLLPRI | EPOLLET;
+                geo->_epoll_event.data.ptr = geo.get();
+
+                if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, geo->fd, &geo->_epoll_event) == -1)
                 {
-                    geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::NONE;
+                    // Error - Leave loop immediately
+                    std::perror("epoll_ctl()");
+
+                    return -1;
                 }
-                break;
-                case _gpioEventObject::ModifyEvent::MODIFY:
+                geo->in_epoll = true;
+
+                // Avoid the initial event (that would have occurred before this unit has been added)
+                geo->_epoll_change_flag = geo->backend->initial_edge_event()
+                                              ? _gpioEventObject::ModifyEvent::INITIAL_ABSCOND
+                                              : _gpioEventObject::ModifyEvent::NONE;
+                if (geo->_epoll_change_flag == _gpioEventObject::ModifyEvent::INITIAL_ABSCOND)
+                    _epoll_abscond_pending = true;
+            }
+            break;
+            case _gpioEventObject::ModifyEvent::REMOVE:
+            {
+                if (geo->blocking_usage)
                 {
-                    // For now this just means modification of the edge type, which is done on the calling thread
-                    // Just set back to NONE and continue
-                    geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::NONE;
+                    // Do not remove it during a concurrent blocking usage
+                    break;
                 }
-                break;
-                case _gpioEventObject::ModifyEvent::ADD:
-                {
-                    geo->_epoll_event.events = EPOLLIN | EPOLLPRI | EPOLLET;
-                    geo->_epoll_event.data.fd = geo->fd;
 
-                    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, geo->fd, &geo->_epoll_event) == -1)
-                    {
-                        // Error - Leave loop immediately
-                        std::perror("epoll_ctl()");
+                geo_it = _epoll_thread_remove_event(epoll_fd, geo_it);
 
-                        return cleanup_and_return();
-                    }
+                // Skip past the iteration so as to not iterate past the returned element
+                // -- (which is the next element)
+                continue;
+            }
+            }
 
-                    // Avoid the initial event (that would have occurred before this unit has been added)
-                    geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::INITIAL_ABSCOND;
-                }
-                break;
-                case _gpioEventObject::ModifyEvent::REMOVE:
-                {
-                    if (geo->blocking_usage)
-                    {
-                        // Do not remove it during a concurrent blocking usage
-                        break;
-                    }
+            // Iterate to next element
+            geo_it++;
+        }
 
-                    geo_it = _epoll_thread_remove_event(epoll_fd, geo_it);
+        return (int)_edge_batch.size();
+    }
 
-                    // Skip past the iteration so as to not iterate past the returned element
-                    // -- (which is the next element)
-                    continue;
-                }
-                }
+    // epoll file descriptor with _epoll_wake_fd in its set, or -1
+    int _epoll_open()
+    {
+        int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd == -1)
+        {
+            std::perror("[Fatal Error] Failed to create epoll file descriptor for concurrent Epoll Thread\n");
+            return -1;
+        }
 
-                // Iterate to next element
-                geo_it++;
+        epoll_event wake_event{};
+        wake_event.events = EPOLLIN;
+        wake_event.data.ptr = nullptr;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, _epoll_wake_fd, &wake_event) == -1)
+        {
+            std::perror("[Fatal Error] Failed to add the wake-up eventfd to the concurrent Epoll Thread");
+            close(epoll_fd);
+            return -1;
+        }
+
+        _glitch_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        epoll_event timer_event{};
+        timer_event.events = EPOLLIN;
+        timer_event.data.ptr = &_glitch_timer_tag;
+        if (_glitch_timer_fd == -1 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, _glitch_timer_fd, &timer_event) == -1)
+        {
+            std::perror("[Fatal Error] Failed to add the glitch filter timer to the concurrent Epoll Thread");
+            if (_glitch_timer_fd != -1)
+                close(_glitch_timer_fd);
+            _glitch_timer_fd = -1;
+            close(epoll_fd);
+            return -1;
+        }
+        _glitch_timer_armed_ns = 0;
+        return epoll_fd;
+    }
+
+    void _epoll_thread_loop()
+    {
+        int epoll_fd = _epoll_open();
+        if (epoll_fd == -1)
+            return;
+        {
+            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            _epoll_thread_fd = epoll_fd;
+        }
+
+        while (_epoll_run_loop)
+        {
+            // Blocks until an edge or a change queued by _epoll_wake_thread()
+            if (_epoll_process(epoll_fd, -1, nullptr) == -1)
+                break;
+        }
+
+        // Cleanup - thread is ending
+        // -- GPIO Event Objects
+        {
+            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            for (auto geo_it = _gpio_events.begin(); geo_it != _gpio_events.end();)
+            {
+                geo_it = _epoll_thread_remove_event(epoll_fd, geo_it);
             }
+
+            close(_glitch_timer_fd);
+            _glitch_timer_fd = -1;
+            _epoll_thread_fd = -1;
         }
 
-        return cleanup_and_return();
+        // epoll
+        if (close(epoll_fd) == -1)
+        {
+            std::perror("[WARNING] Failed to close epoll file descriptor during closure of concurrent Epoll_Thread\n");
+        }
     }
 
-    void _epoll_start_thread()
+    int _epoll_start_thread()
     {
+        _epoll_wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_epoll_wake_fd == -1)
+        {
+            std::perror("eventfd()");
+            return (int)EventResultCode::EpollWakeFD_CreateError;
+        }
+
         _epoll_run_loop = true;
         _epoll_fd_thread = std::make_unique<std::thread>(_epoll_thread_loop);
+        return 0;
     }
 
     void _epoll_end_thread()
     {
         _epoll_run_loop = false;
+        _epoll_wake_thread();
 
         // Wait to join
         _epoll_fd_thread->join();
@@ -393,260 +863,450 @@ namespace GPIO
             // Enter Mutex and clear thread
             std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
             _epoll_fd_thread = nullptr;
+
+            close(_epoll_wake_fd);
+            _epoll_wake_fd = -1;
         }
     }
 
-    //-------------- Operations -------------------- //
+    //-------------- Blocking Wait -------------------- //
 
-    int _blocking_wait_for_edge(int gpio, const std::string& gpio_name, const std::string& channel_id, Edge edge,
-                                uint64_t bounce_time, uint64_t timeout)
+    /* epoll_wait() until the CLOCK_MONOTONIC time deadline_ns, or without a time limit if deadline_ns is negative.
+       Uses epoll_pwait2() for a nanosecond timeout when the kernel has it, otherwise the remaining time is rounded
+       up to milliseconds. Returns 0 when the deadline has passed. */
+    int _epoll_wait_until(int epoll_fd, epoll_event* events, int max_events, int64_t deadline_ns)
     {
-        timespec timeout_time{};
-        if (timeout)
-        {
-            clock_gettime(CLOCK_REALTIME, &timeout_time);
+        if (deadline_ns < 0)
+            return epoll_wait(epoll_fd, events, max_events, -1);
 
-            timeout_time.tv_nsec += (timeout % 1000) * 1e6;
-            long overlap = timeout_time.tv_nsec / 1e9;
-            timeout_time.tv_nsec -= overlap;
+        int64_t remaining_ns = deadline_ns - _monotonic_ns();
+        if (remaining_ns <= 0)
+            return 0;
 
-            timeout_time.tv_sec += timeout / 1000 + overlap;
+#ifdef SYS_epoll_pwait2
+        static std::atomic_bool pwait2_supported{true};
+        if (pwait2_supported)
+        {
+            timespec timeout{(time_t)(remaining_ns / 1000000000), (long)(remaining_ns % 1000000000)};
+            int result = (int)syscall(SYS_epoll_pwait2, epoll_fd, events, max_events, &timeout, nullptr, 0);
+            if (result != -1 || errno != ENOSYS)
+                return result;
+
+            pwait2_supported = false;
         }
+#endif
+
+        int64_t timeout_ms = (remaining_ns + 999999) / 1000000;
+        return epoll_wait(epoll_fd, events, max_events, (int)std::min<int64_t>(timeout_ms, INT32_MAX));
+    }
+
+    /* The epoll instance of the blocking waits of the calling thread, created by the first wait. The edge fds are
+       added at the start of each wait and removed at its end. */
+    int _blocking_epoll_fd()
+    {
+        thread_local FileDescriptor epoll_fd{};
+        if (!epoll_fd.is_open())
+            epoll_fd = FileDescriptor(epoll_create1(EPOLL_CLOEXEC));
+        return epoll_fd.get();
+    }
+
+    //-------------- Operations -------------------- //
 
+    /* Mark the event object of a channel as used by a blocking wait. It is created if the channel has no edge
+       detection yet, in which case opened is set. */
+    int _acquire_blocking_usage(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
+                                uint64_t bounce_time, std::shared_ptr<_gpioEventObject>& geo, bool& opened)
+    {
+        const int gpio = ch_info.gpio;
         int result{};
-        std::shared_ptr<_gpioEventObject> geo{};
+        opened = false;
+
+        // Enter Mutex
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
 
+        // Ensure a conflict does not exist with the concurrent event detecting thread and its collection of gpio
+        // events
+        auto find_result = _gpio_events.find(gpio);
+        if (find_result != _gpio_events.end())
         {
-            // Enter Mutex
-            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            geo = find_result->second;
 
-            // Ensure a conflict does not exist with the concurrent event detecting thread and its collection of gpio
-            // events
-            auto find_result = _gpio_events.find(gpio);
-            if (find_result != _gpio_events.end())
+            if (geo->blocking_usage)
             {
-                geo = find_result->second;
+                // Channel already being blocked (can only be by another thread call)
+                return (int)GPIO::EventResultCode::ChannelAlreadyBlocked;
+            }
 
-                if (geo->blocking_usage)
+            switch (geo->_epoll_change_flag)
+            {
+            case _gpioEventObject::ModifyEvent::NONE:
+            case _gpioEventObject::ModifyEvent::ADD:
+            case _gpioEventObject::ModifyEvent::MODIFY:
+            {
+                if (geo->sink)
                 {
-                    // Channel already being blocked (can only be by another thread call)
-                    return (int)GPIO::EventResultCode::ChannelAlreadyBlocked;
+                    return (int)GPIO::EventResultCode::EdgeSinkConflict;
                 }
-
-                switch (geo->_epoll_change_flag)
+                if (geo->edge != edge)
                 {
-                case _gpioEventObject::ModifyEvent::NONE:
-                case _gpioEventObject::ModifyEvent::ADD:
-                case _gpioEventObject::ModifyEvent::MODIFY:
+                    return (int)GPIO::EventResultCode::ConflictingEdgeType;
+                }
+                if (bounce_time && geo->bounce_time != bounce_time)
                 {
-                    if (geo->edge != edge)
-                    {
-                        return (int)GPIO::EventResultCode::ConflictingEdgeType;
-                    }
-                    if (bounce_time && geo->bounce_time != bounce_time)
+                    return (int)GPIO::EventResultCode::ConflictingBounceTime;
+                }
+            }
+            break;
+            case _gpioEventObject::ModifyEvent::REMOVE:
+            {
+                if (geo->fd == -1)
+                {
+                    // Closed on removal (_remove_edge_detect_locked())
+                    geo->edge = edge;
+                    result = backend->open_edge(ch_info, edge, geo->fd);
+                    if (result)
                     {
-                        return (int)GPIO::EventResultCode::ConflictingBounceTime;
+                        return result;
                     }
                 }
-                break;
-                case _gpioEventObject::ModifyEvent::REMOVE:
-                {
-                    // The epoll thread is inbetween concurrent transactions. Modify the existing
-                    // object instead of removing it
 
-                    if (geo->edge != edge)
-                    {
-                        // Update
+                // The epoll thread is inbetween concurrent transactions. Modify the existing
+                // object instead of removing it. If the thread hasn't added it yet, it is still to be added.
+                if (!geo->in_epoll)
+                    geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::ADD;
+
+                if (geo->edge != edge)
+                {
+                    // Update
+                    if (geo->in_epoll)
                         geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::MODIFY;
-                        geo->edge = edge;
+                    geo->edge = edge;
 
-                        // Set Event
-                        result = _write_sysfs_edge(gpio_name, edge);
-                        if (result)
-                        {
-                            return result;
-                        }
+                    // Set Event
+                    result = backend->set_edge(ch_info, edge);
+                    if (result)
+                    {
+                        return result;
                     }
+                }
 
-                    // Reset GPIO
-                    geo->event_occurred = false;
-                    geo->bounce_time = bounce_time;
-                    geo->last_event = 0;
+                // Reset GPIO
+                geo->event_occurred = false;
+                _set_bounce_time(*geo, ch_info, bounce_time);
+                geo->last_event_ns = 0;
+                geo->seqno = 0;
 
-                    ++_auth_event_channel_count;
+                ++_auth_event_channel_count;
+            }
+            break;
+            default:
+                // Shouldn't happen
+                return (int)GPIO::EventResultCode::InternalTrackingError;
+            }
+        }
+        else
+        {
+            // Create a gpio-event-object to avoid concurrent conflicts for the channel while blocking
+            geo = std::make_shared<_gpioEventObject>();
+            geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::ADD;
+            geo->gpio = gpio;
+            geo->channel_id = ch_info.channel;
+            geo->callbacks = std::make_shared<CallbackList>();
+            geo->backend = backend;
+            geo->edge = edge;
+            geo->bounce_time = 0;
+            geo->last_event_ns = 0;
+            geo->seqno = 0;
+
+            // Open the event fd & set Event
+            result = backend->open_edge(ch_info, edge, geo->fd);
+            if (result)
+            {
+                return result;
+            }
+
+            // Set
+            _gpio_events[gpio] = geo;
+            _register_counters(*geo);
+            _set_bounce_time(*geo, ch_info, bounce_time);
+
+            ++_auth_event_channel_count;
+            opened = true;
+        }
+
+        geo->blocking_usage = true;
+        geo->waiter_fired = false;
+        return 0;
+    }
+
+    // With _epmutex held. Returns true if the epoll thread must be ended, which is done after releasing _epmutex.
+    bool _remove_edge_detect_locked(int gpio)
+    {
+        auto find_result = _gpio_events.find(gpio);
+        if (find_result == _gpio_events.end())
+            return false;
+
+        auto geo = find_result->second;
+
+        geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::REMOVE;
+        --_auth_event_channel_count;
+        geo->concurrent_usage = false;
+
+        // Remove all callbacks right now, including the calls still waiting for a callback worker
+        geo->callbacks = std::make_shared<CallbackList>();
+        _callback_dispatcher.discard(gpio);
+
+        geo->event_buffer = nullptr;
+        geo->sink = nullptr;
+        geo->glitch_window_ns = 0;
+        geo->reflexes.clear();
+        _drop_pending_edge(*geo);
+        {
+            std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+            _event_buffers.erase(gpio);
+            _pulse_counters.erase(gpio);
+        }
+
+        if (geo->blocking_usage)
+        {
+            // Channel is currently in a blocking usage on a concurrent thread
+            return false;
+        }
+
+        // Now rather than when the event loop erases the object: the channel can be set up again right away
+        _close_edge_fd(_embedded_epoll_fd != -1 ? _embedded_epoll_fd : _epoll_thread_fd, *geo);
+
+        if (_auth_event_channel_count == 0 && _epoll_fd_thread)
+        {
+            // Signal shutdown of thread
+            // -- Doesn't need to run if there are no events
+            return true;
+        }
+
+        _epoll_wake_thread();
+        return false;
+    }
+
+    // Undo _acquire_blocking_usage() at the end of a blocking wait
+    void _release_blocking_usage(const std::shared_ptr<_gpioEventObject>& geo)
+    {
+        const int gpio = geo->gpio;
+
+        // Enter Mutex
+        std::unique_lock<std::recursive_mutex> mutex_lock(_epmutex);
+        geo->blocking_usage = false;
+        if (geo->concurrent_usage)
+        {
+            // Give the fd back to the event thread: it adds it to its epoll set, or reads the edges left in it
+            if (geo->in_epoll)
+                _epoll_drain_pending.push_back(gpio);
+            _epoll_wake_thread();
+        }
+        else
+        {
+            // Remove it
+            if (!geo->in_epoll)
+            {
+                // It hasn't been added to the concurrent epoll-thread yet (if there even is one)
+                // Close the fd
+                if (close(geo->fd) == -1)
+                {
+                    std::cerr << "[WARNING] Failed to close Epoll_Thread file descriptor\n";
                 }
-                break;
-                default:
-                    // Shouldn't happen
-                    return (int)GPIO::EventResultCode::InternalTrackingError;
+
+                _clear_kernel_debounce(*geo);
+                auto geo_it = _gpio_events.find(gpio);
+                if (geo_it != _gpio_events.end())
+                    _gpio_events.erase(geo_it);
+                _erase_counters(gpio);
+
+                --_auth_event_channel_count;
+                if (_auth_event_channel_count == 0 && _epoll_fd_thread)
+                {
+                    // Signal shutdown of thread
+                    // -- Doesn't need to run if there are no events
+                    mutex_lock.unlock();
+                    _epoll_end_thread();
                 }
             }
             else
             {
-                // Create a gpio-event-object to avoid concurrent conflicts for the channel while blocking
-                geo = std::make_shared<_gpioEventObject>();
-                geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::ADD;
-                geo->gpio = gpio;
-                geo->channel_id = channel_id;
-                geo->edge = edge;
-                geo->bounce_time = bounce_time;
-                geo->last_event = 0;
-
-                // Open the value fd
-                result = _open_sysfd_value(gpio_name, geo->fd);
-                if (result)
+                // Set for removal from the concurrent epoll-thread
+                if (_remove_edge_detect_locked(gpio))
                 {
-                    return result;
+                    mutex_lock.unlock();
+                    _epoll_end_thread();
                 }
+            }
+        }
+    }
 
-                // Set Event
-                result = _write_sysfs_edge(gpio_name, edge);
-                if (result)
-                {
-                    close(geo->fd);
-                    return result;
-                }
+    int _blocking_wait_for_edge(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
+                                uint64_t bounce_time, uint64_t timeout)
+    {
+        std::vector<EdgeEvent> detected{};
+        return _blocking_wait_for_edges(backend, {ch_info}, edge, bounce_time, timeout, detected);
+    }
 
-                // Set
-                _fd_to_gpio_map[geo->fd] = gpio;
-                _gpio_events[gpio] = geo;
+    int _blocking_wait_for_edges(const std::shared_ptr<Backend>& backend, const std::vector<ChannelInfo>& ch_infos,
+                                 Edge edge, uint64_t bounce_time, uint64_t timeout, std::vector<EdgeEvent>& detected)
+    {
+        detected.clear();
 
-                ++_auth_event_channel_count;
-            }
+        const int64_t deadline_ns = timeout ? _monotonic_ns() + (int64_t)timeout * 1000000 : -1;
+
+        struct BlockingChannel
+        {
+            std::shared_ptr<_gpioEventObject> geo;
+            bool skip_initial; // the first edge of a newly opened fd is the current state
+            bool fired;
+            EdgeEvent first;   // the first edge detected
+        };
+
+        std::vector<BlockingChannel> channels{};
+        int error = 0;
+        for (const auto& ch_info : ch_infos)
+        {
+            std::shared_ptr<_gpioEventObject> geo{};
+            bool opened = false;
+            error = _acquire_blocking_usage(backend, ch_info, edge, bounce_time, geo, opened);
+            if (error)
+                break;
 
-            geo->blocking_usage = true;
+            channels.push_back({geo, opened && backend->initial_edge_event(), false, EdgeEvent{}});
         }
 
         // Execute the epoll awaiting the event
-        int epoll_fd = 0, error = 0;
+        int epoll_fd = -1;
+        size_t added = 0;
 
         auto cleanup_and_return_result = [&]() -> int
         {
-            if (epoll_fd >= 0)
-                close(epoll_fd);
+            // The epoll instance is kept for the next wait of this thread
+            for (size_t i = 0; i < added; i++)
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, channels[i].geo->fd, nullptr);
 
             // GPIO Event Object Tidy-up
-            {
-                // Enter Mutex
-                std::unique_lock<std::recursive_mutex> mutex_lock(_epmutex);
-                geo->blocking_usage = false;
-                if (!geo->concurrent_usage)
-                {
-                    // Remove it
-                    if (geo->_epoll_change_flag == _gpioEventObject::ModifyEvent::ADD)
-                    {
-                        // It hasn't been added to the concurrent epoll-thread yet (if there even is one)
-                        auto ftg_it = _fd_to_gpio_map.find(geo->fd);
-                        if (ftg_it != _fd_to_gpio_map.end())
-                            _fd_to_gpio_map.erase(ftg_it);
-
-                        // Close the fd
-                        if (close(geo->fd) == -1)
-                        {
-                            std::cerr << "[WARNING] Failed to close Epoll_Thread file descriptor\n";
-                        }
-
-                        auto geo_it = _gpio_events.find(gpio);
-                        if (geo_it != _gpio_events.end())
-                            _gpio_events.erase(geo_it);
-
-                        --_auth_event_channel_count;
-                        if (_auth_event_channel_count == 0 && _epoll_fd_thread)
-                        {
-                            // Signal shutdown of thread
-                            // -- Doesn't need to run if there are no events
-                            mutex_lock.unlock();
-                            _epoll_end_thread();
-                        }
-                    }
-                    else
-                    {
-                        // Set for removal from the concurrent epoll-thread
-                        _remove_edge_detect(gpio);
-                    }
-                }
-            }
+            for (const auto& channel : channels)
+                _release_blocking_usage(channel.geo);
 
             if (error)
                 return error;
-            return result;
+            return detected.empty() ? (int)EventResultCode::None : (int)EventResultCode::EdgeDetected;
         };
 
-        result = (int)EventResultCode::None; // 0
+        if (error)
+            return cleanup_and_return_result();
+
+        epoll_fd = _blocking_epoll_fd();
+        if (epoll_fd == -1)
         {
-            epoll_fd = epoll_create1(0);
-            if (epoll_fd == -1)
-            {
-                error = (int)GPIO::EventResultCode::EpollFD_CreateError;
-                std::perror("epoll_create1(0)");
-                return cleanup_and_return_result();
-            }
+            error = (int)GPIO::EventResultCode::EpollFD_CreateError;
+            std::perror("epoll_create1()");
+            return cleanup_and_return_result();
+        }
 
-            geo->_epoll_event.events = EPOLLIN | EPOLLPRI | EPOLLET;
-            geo->_epoll_event.data.fd = geo->fd;
+        // One epoll set for all the channels. The event data is the index of the channel.
+        for (; added < channels.size(); added++)
+        {
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLPRI | EPOLLET;
+            event.data.u64 = added;
 
-            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, geo->fd, &geo->_epoll_event) == -1)
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, channels[added].geo->fd, &event) == -1)
             {
-                close(epoll_fd);
                 std::perror("epoll_ctl():");
                 error = (int)GPIO::EventResultCode::EpollCTL_Add;
                 return cleanup_and_return_result();
             }
+        }
 
-            epoll_event events[1]{};
-            bool initial_edge = true;
-
-            // Remove Initial Event
-            timespec current_time{};
-            while (true)
+        epoll_event events[MAX_EPOLL_EVENTS]{};
+        while (detected.empty())
+        {
+            // Sleep until an edge, the end of the hold of an edge by a glitch filter, or the deadline
+            int64_t wake_deadline_ns = deadline_ns;
             {
-                if (timeout)
+                std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+                for (const auto& channel : channels)
                 {
-                    clock_gettime(CLOCK_REALTIME, &current_time);
-                    if (current_time.tv_sec > timeout_time.tv_sec ||
-                        (current_time.tv_sec == timeout_time.tv_sec && current_time.tv_nsec >= timeout_time.tv_nsec))
-                    {
-                        // Time-out
-                        break;
-                    }
+                    if (channel.geo->glitch_pending &&
+                        (wake_deadline_ns < 0 || (int64_t)channel.geo->pending_deadline_ns < wake_deadline_ns))
+                        wake_deadline_ns = (int64_t)channel.geo->pending_deadline_ns;
                 }
+            }
 
-                // Wait a small time for events
-                int event_count = epoll_wait(epoll_fd, events, 1, 1);
-
-                // First trigger is with current state so ignore
-                if (initial_edge)
-                {
-                    initial_edge = false;
+            int event_count = _epoll_wait_until(epoll_fd, events, MAX_EPOLL_EVENTS, wake_deadline_ns);
+            if (event_count == 0 && wake_deadline_ns == deadline_ns)
+            {
+                // Time-out
+                break;
+            }
+            if (event_count == -1)
+            {
+                if (errno == EINTR)
                     continue;
-                }
 
-                // Handle Events
-                if (event_count)
+                std::perror("epoll_wait");
+                error = (int)EventResultCode::EpollWait;
+                break;
+            }
+
+            // Handle Events. Each channel that fired reports its first edge passing the filters.
+            const uint64_t wake_ns = _monotonic_ns();
+            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            for (int e = 0; e < event_count; e++)
+            {
+                auto& channel = channels[events[e].data.u64];
+                EdgeRecord records[MAX_EDGE_RECORDS];
+                size_t record_count = 0;
+                do
                 {
-                    if (event_count == -1)
+                    record_count = backend->read_edges(channel.geo->fd, records, MAX_EDGE_RECORDS);
+                    for (size_t r = 0; r < record_count; r++)
                     {
-                        if (errno != EINTR)
+                        if (channel.skip_initial)
                         {
-                            std::perror("epoll_wait");
-                            error = (int)EventResultCode::EpollWait;
+                            channel.skip_initial = false;
+                            continue;
                         }
-                        return cleanup_and_return_result();
-                    }
-
-                    if (events[0].data.fd == geo->fd)
-                    {
-                        auto tick = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
-                                        std::chrono::system_clock::now().time_since_epoch())
-                                        .count();
 
-                        if (!geo->bounce_time || tick - geo->last_event > geo->bounce_time)
+                        /* The event thread doesn't read the fd during the wait: the edges of a channel with event
+                           detection are fired here as well, and reported when _deliver_edge() delivers them */
+                        if (channel.geo->concurrent_usage &&
+                            channel.geo->_epoll_change_flag == _gpioEventObject::ModifyEvent::NONE)
                         {
-                            result = (int)EventResultCode::EdgeDetected;
-                            break;
+                            _epoll_thread_fire_event(*channel.geo, records[r], wake_ns, nullptr);
+                            continue;
                         }
+
+                        channel.geo->counters->add_edge();
+                        if (!_passes_bounce_time(*channel.geo, records[r], wake_ns) || channel.fired)
+                            continue;
+
+                        _make_edge_event(*channel.geo, records[r], wake_ns, channel.first);
+                        channel.fired = true;
                     }
+                } while (record_count == MAX_EDGE_RECORDS);
+            }
+
+            // The edges held by a glitch filter whose window has passed. The event thread settles them too.
+            if (!_glitch_pending.empty())
+                _settle_pending_edges(nullptr);
+
+            for (auto& channel : channels)
+            {
+                if (!channel.fired && channel.geo->waiter_fired)
+                {
+                    channel.first = channel.geo->waiter_event;
+                    channel.fired = true;
                 }
+                if (channel.fired)
+                    detected.push_back(channel.first);
+
+                // The event thread arms the timer of the edges held by the glitch filter
+                if (channel.geo->glitch_pending)
+                    _epoll_wake_thread();
             }
         }
 
@@ -684,9 +1344,11 @@ namespace GPIO
         return false;
     }
 
-    int _add_edge_detect(int gpio, const std::string& gpio_name, const std::string& channel_id, Edge edge,
+    int _add_edge_detect(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
                          uint64_t bounce_time)
     {
+        const int gpio = ch_info.gpio;
+
         int result{};
 
         // Enter Mutex
@@ -705,6 +1367,10 @@ namespace GPIO
             case _gpioEventObject::ModifyEvent::ADD:
             case _gpioEventObject::ModifyEvent::MODIFY:
             {
+                if (geo->sink)
+                {
+                    return (int)GPIO::EventResultCode::EdgeSinkConflict;
+                }
                 if (geo->edge != edge)
                 {
                     return (int)GPIO::EventResultCode::ConflictingEdgeType;
@@ -719,24 +1385,36 @@ namespace GPIO
             break;
             case _gpioEventObject::ModifyEvent::REMOVE:
             {
+                if (geo->fd == -1)
+                {
+                    // Closed on removal (_remove_edge_detect_locked())
+                    geo->edge = edge;
+                    result = backend->open_edge(ch_info, edge, geo->fd);
+                    if (result)
+                    {
+                        return result;
+                    }
+                }
+
                 // The epoll thread is inbetween concurrent transactions. Modify the existing
-                // object instead of removing it
+                // object instead of removing it (even if the edge is the same), or add it if the thread hasn't yet
+                geo->_epoll_change_flag =
+                    geo->in_epoll ? _gpioEventObject::ModifyEvent::MODIFY : _gpioEventObject::ModifyEvent::ADD;
 
                 if (geo->edge != edge)
                 {
                     // Update
-                    geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::MODIFY;
                     geo->edge = edge;
 
                     // Set Event
-                    result = _write_sysfs_edge(gpio_name, edge);
+                    result = backend->set_edge(ch_info, edge);
                     if (result)
                     {
                         return result;
                     }
                 }
-                geo->bounce_time = bounce_time;
-                geo->last_event = 0;
+                geo->last_event_ns = 0;
+                geo->seqno = 0;
                 ++_auth_event_channel_count;
             }
             break;
@@ -751,41 +1429,44 @@ namespace GPIO
             geo = std::make_shared<_gpioEventObject>();
             geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::ADD;
             geo->gpio = gpio;
-            geo->channel_id = channel_id;
+            geo->channel_id = ch_info.channel;
+            geo->callbacks = std::make_shared<CallbackList>();
+            geo->backend = backend;
             geo->edge = edge;
-            geo->last_event = 0;
+            geo->bounce_time = 0;
+            geo->last_event_ns = 0;
+            geo->seqno = 0;
             geo->blocking_usage = false;
             geo->event_occurred = false;
 
-            // Open the value fd
-            result = _open_sysfd_value(gpio_name, geo->fd);
-            if (result)
-            {
-                return result;
-            }
-            _fd_to_gpio_map[geo->fd] = gpio;
-
-            // Set Event
-            result = _write_sysfs_edge(gpio_name, edge);
+            // Open the event fd & set Event
+            result = backend->open_edge(ch_info, edge, geo->fd);
             if (result)
             {
-                close(geo->fd);
                 return result;
             }
 
             // Set
             _gpio_events[gpio] = geo;
+            _register_counters(*geo);
             ++_auth_event_channel_count;
         }
 
-        geo->bounce_time = bounce_time;
+        _set_bounce_time(*geo, ch_info, bounce_time);
         geo->concurrent_usage = true;
 
-        if (!_epoll_fd_thread)
+        if (!_epoll_fd_thread && _embedded_epoll_fd == -1)
         {
-            _epoll_start_thread();
+            result = _epoll_start_thread();
+            if (result)
+            {
+                return result;
+            }
         }
 
+        // Let the thread add the new event object to its epoll set
+        _epoll_wake_thread();
+
         return 0;
     }
 
@@ -794,30 +1475,13 @@ namespace GPIO
         // Enter Mutex
         std::unique_lock<std::recursive_mutex> mutex_lock(_epmutex);
 
-        auto find_result = _gpio_events.find(gpio);
-        if (find_result != _gpio_events.end())
-        {
-            auto geo = find_result->second;
-
-            geo->_epoll_change_flag = _gpioEventObject::ModifyEvent::REMOVE;
-            --_auth_event_channel_count;
-            geo->concurrent_usage = false;
-            if (geo->blocking_usage)
-            {
-                // Channel is currently in a blocking usage on a concurrent thread
-                // -- At least remove all callbacks right now
-                geo->callbacks.clear();
-                return;
-            }
+        bool end_thread = _remove_edge_detect_locked(gpio);
+        mutex_lock.unlock();
+        if (end_thread)
+            _epoll_end_thread();
 
-            if (_auth_event_channel_count == 0 && _epoll_fd_thread)
-            {
-                // Signal shutdown of thread
-                // -- Doesn't need to run if there are no events
-                mutex_lock.unlock();
-                _epoll_end_thread();
-            }
-        }
+        // No callback of the channel runs after the return. Without _epmutex, which the callbacks may take.
+        _callback_dispatcher.wait_idle(gpio);
     }
 
     int _add_edge_callback(int gpio, const Callback& callback)
@@ -831,7 +1495,14 @@ namespace GPIO
         }
 
         auto geo = find_result->second;
-        geo->callbacks.push_back(callback);
+        if (geo->sink)
+        {
+            return (int)GPIO::EventResultCode::EdgeSinkConflict;
+        }
+
+        auto callbacks = std::make_shared<CallbackList>(*geo->callbacks);
+        callbacks->push_back(callback);
+        geo->callbacks = callbacks;
 
         return 0;
     }
@@ -848,19 +1519,326 @@ namespace GPIO
         }
 
         auto geo = find_result->second;
-        for (auto geo_it = geo->callbacks.begin(); geo_it != geo->callbacks.end();)
+        auto callbacks = std::make_shared<CallbackList>(*geo->callbacks);
+        for (auto cb_it = callbacks->begin(); cb_it != callbacks->end();)
         {
-            if (*geo_it == callback)
+            if (*cb_it == callback)
             {
-                geo->callbacks.erase(geo_it);
+                cb_it = callbacks->erase(cb_it);
             }
             else
             {
-                geo_it++;
+                cb_it++;
+            }
+        }
+        geo->callbacks = callbacks;
+    }
+
+    int _set_event_buffer(int gpio, size_t size)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        auto find_result = _gpio_events.find(gpio);
+        if (find_result == _gpio_events.end() ||
+            find_result->second->_epoll_change_flag == _gpioEventObject::ModifyEvent::REMOVE)
+        {
+            return (int)GPIO::EventResultCode::GPIO_Event_Not_Found;
+        }
+
+        auto geo = find_result->second;
+        geo->event_buffer = size ? std::make_shared<EventRing>(size) : nullptr;
+
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        if (geo->event_buffer)
+            _event_buffers[gpio] = geo->event_buffer;
+        else
+            _event_buffers.erase(gpio);
+
+        return 0;
+    }
+
+    int _set_glitch_filter(const ChannelInfo& ch_info, uint64_t window_ns)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        auto find_result = _gpio_events.find(ch_info.gpio);
+        if (find_result == _gpio_events.end() || !find_result->second->concurrent_usage ||
+            find_result->second->_epoll_change_flag == _gpioEventObject::ModifyEvent::REMOVE)
+        {
+            return (int)GPIO::EventResultCode::GPIO_Event_Not_Found;
+        }
+
+        auto& geo = find_result->second;
+        if (geo->sink)
+        {
+            return (int)GPIO::EventResultCode::EdgeSinkConflict;
+        }
+
+        if (window_ns)
+        {
+            // an edge held already is settled as it was
+            geo->glitch_channel = std::make_shared<ChannelInfo>(ch_info);
+            try
+            {
+                geo->stable_level = geo->backend->read(ch_info);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "[WARNING] " << e.what() << std::endl;
+                return (int)GPIO::EventResultCode::InternalTrackingError;
+            }
+        }
+        geo->glitch_window_ns = window_ns;
+        return 0;
+    }
+
+    int _add_reflex(const ChannelInfo& input, Edge edge, const ChannelInfo& output, int value)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        auto find_result = _gpio_events.find(input.gpio);
+        if (find_result == _gpio_events.end() || !find_result->second->concurrent_usage ||
+            find_result->second->_epoll_change_flag == _gpioEventObject::ModifyEvent::REMOVE)
+        {
+            return (int)GPIO::EventResultCode::GPIO_Event_Not_Found;
+        }
+
+        auto& geo = find_result->second;
+        if (geo->sink)
+        {
+            return (int)GPIO::EventResultCode::EdgeSinkConflict;
+        }
+        if (edge != Edge::RISING && edge != Edge::FALLING && edge != Edge::BOTH)
+        {
+            return (int)GPIO::EventResultCode::IllegalEdgeArgument;
+        }
+
+        geo->reflexes.push_back({edge, std::make_shared<ChannelInfo>(output), value});
+        return 0;
+    }
+
+    void _clear_reflexes(int gpio)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        auto find_result = _gpio_events.find(gpio);
+        if (find_result != _gpio_events.end())
+            find_result->second->reflexes.clear();
+    }
+
+    std::vector<bool> _reflex_outputs(size_t channel_count)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        std::vector<bool> outputs(channel_count, false);
+        for (const auto& entry : _gpio_events)
+        {
+            for (const auto& reflex : entry.second->reflexes)
+                outputs.at(reflex.output->id) = true;
+        }
+        return outputs;
+    }
+
+    // The output is released: no reflex may write it from now on
+    void _remove_reflex_outputs(int gpio)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+
+        for (auto& entry : _gpio_events)
+        {
+            auto& reflexes = entry.second->reflexes;
+            reflexes.erase(std::remove_if(reflexes.begin(), reflexes.end(),
+                                          [gpio](const _Reflex& reflex) { return reflex.output->gpio == gpio; }),
+                           reflexes.end());
+        }
+    }
+
+    std::shared_ptr<EventRing> _event_buffer(int gpio)
+    {
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        auto find_result = _event_buffers.find(gpio);
+        return find_result != _event_buffers.end() ? find_result->second : nullptr;
+    }
+
+    int _add_edge_sink(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge,
+                       const std::shared_ptr<EdgeSink>& sink)
+    {
+        return _add_edge_sinks(backend, {ch_info}, edge, sink);
+    }
+
+    int _add_edge_sinks(const std::shared_ptr<Backend>& backend, const std::vector<ChannelInfo>& ch_infos, Edge edge,
+                        const std::shared_ptr<EdgeSink>& sink)
+    {
+        // Held until the sink is set, so that the epoll thread doesn't make an event of an edge of the channels before
+        std::unique_lock<std::recursive_mutex> mutex_lock(_epmutex);
+
+        for (const auto& ch_info : ch_infos)
+        {
+            if (_edge_event_exists(ch_info.gpio))
+            {
+                return (int)GPIO::EventResultCode::EdgeSinkConflict;
+            }
+        }
+
+        /* Read before the edge detection starts: every edge given to the sink then changes a level from these,
+           unless an edge was missed in between. */
+        std::vector<int> levels{};
+        levels.reserve(ch_infos.size());
+        try
+        {
+            for (const auto& ch_info : ch_infos)
+            {
+                levels.push_back(backend->read(ch_info));
+            }
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "[WARNING] " << e.what() << std::endl;
+            return (int)GPIO::EventResultCode::InternalTrackingError;
+        }
+        sink->on_start(levels);
+
+        for (size_t i = 0; i < ch_infos.size(); i++)
+        {
+            int result = _add_edge_detect(backend, ch_infos[i], edge, 0);
+            if (result)
+            {
+                bool end_thread = false;
+                for (size_t added = 0; added < i; added++)
+                {
+                    end_thread = _remove_edge_detect_locked(ch_infos[added].gpio) || end_thread;
+                }
+                if (end_thread)
+                {
+                    mutex_lock.unlock();
+                    _epoll_end_thread();
+                }
+                return result;
             }
+
+            _gpio_events[ch_infos[i].gpio]->sink = sink;
+        }
+
+        return 0;
+    }
+
+    void _remove_edge_sink(int gpio, const std::shared_ptr<EdgeSink>& sink)
+    {
+        std::unique_lock<std::recursive_mutex> mutex_lock(_epmutex);
+
+        auto find_result = _gpio_events.find(gpio);
+        if (find_result != _gpio_events.end() && find_result->second->sink == sink &&
+            _remove_edge_detect_locked(gpio))
+        {
+            // The epoll thread takes _epmutex before it ends: it must not be held here
+            mutex_lock.unlock();
+            _epoll_end_thread();
+        }
+    }
+
+    int _add_pulse_counter(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info, Edge edge)
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+        auto counter = std::make_shared<PulseCounter>();
+        int result = _add_edge_sink(backend, ch_info, edge, counter);
+        if (result)
+        {
+            return result;
+        }
+
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        _pulse_counters[ch_info.gpio] = counter;
+        return 0;
+    }
+
+    std::shared_ptr<PulseCounter> _pulse_counter(int gpio)
+    {
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        auto find_result = _pulse_counters.find(gpio);
+        return find_result != _pulse_counters.end() ? find_result->second : nullptr;
+    }
+
+    void _set_callback_workers(size_t workers) { _callback_dispatcher.set_workers(workers); }
+
+    void _set_callback_queue_size(size_t size) { _callback_dispatcher.set_capacity(size); }
+
+    CallbackStats _callback_stats() { return _callback_dispatcher.stats(); }
+
+    int _event_fd()
+    {
+        std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+        if (_embedded_epoll_fd != -1)
+            return _embedded_epoll_fd;
+
+        if (_epoll_fd_thread)
+            return (int)EventResultCode::EventThreadRunning;
+
+        // Kept open from now on: the caller's event loop polls it
+        _epoll_wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_epoll_wake_fd == -1)
+        {
+            std::perror("eventfd()");
+            return (int)EventResultCode::EpollWakeFD_CreateError;
+        }
+
+        _embedded_epoll_fd = _epoll_open();
+        if (_embedded_epoll_fd == -1)
+        {
+            close(_epoll_wake_fd);
+            _epoll_wake_fd = -1;
+            return (int)EventResultCode::EpollFD_CreateError;
+        }
+        return _embedded_epoll_fd;
+    }
+
+    int _process_events()
+    {
+        int epoll_fd = -1;
+        {
+            std::lock_guard<std::recursive_mutex> mutex_lock(_epmutex);
+            epoll_fd = _embedded_epoll_fd;
+        }
+        if (epoll_fd == -1)
+            return (int)EventResultCode::EventLoopNotEmbedded;
+
+        // Local, so that a callback can call _process_events() again
+        std::vector<_PendingCallbacks> calls{};
+        int result = _epoll_process(epoll_fd, 0, &calls);
+        if (result == -1)
+            return (int)EventResultCode::EpollWait;
+
+        // Without _epmutex held, like the callback workers
+        for (const auto& call : calls)
+        {
+            run_callbacks(*call.callbacks, call.event, call.counters.get());
+        }
+        return result;
+    }
+
+    EventStats _event_stats()
+    {
+        EventStats stats{};
+        stats.wakeups = _epoll_wakeups.load(std::memory_order_relaxed);
+        stats.full_batches = _epoll_full_batches.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> readers_lock(_readers_mutex);
+        stats.channels.reserve(_event_counters.size());
+        for (const auto& counters : _event_counters)
+        {
+            stats.channels.push_back(counters.second->read());
         }
+        return stats;
+    }
+
+    std::unique_lock<std::recursive_mutex> _lock_line_requests()
+    {
+        return std::unique_lock<std::recursive_mutex>(_epmutex);
     }
 
-    void _event_cleanup(int gpio, const std::string& gpio_name) { _remove_edge_detect(gpio); }
+    void _event_cleanup(int gpio)
+    {
+        _remove_reflex_outputs(gpio);
+        _remove_edge_detect(gpio);
+    }
 
 } // namespace GPIO
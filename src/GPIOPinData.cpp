@@ -672,6 +672,7 @@ namespace GPIO
             map<string, string> gpio_chip_dirs{};
             map<string, int> gpio_chip_base{};
             map<string, string> gpio_chip_ngpio{};
+            map<string, string> gpio_chip_cdevs{};
             map<string, string> pwm_dirs{};
 
             vector<string> sysfs_prefixes = {"/sys/devices/", "/sys/devices/platform/", "/sys/bus/platform/devices/"};
@@ -701,6 +702,19 @@ namespace GPIO
                     throw runtime_error("Cannot find GPIO chip " + gpio_chip_name);
 
                 gpio_chip_dirs[gpio_chip_name] = gpio_chip_dir;
+
+                // the character device of the chip is listed as a child device (e.g. gpiochip0 -> /dev/gpiochip0)
+                string gpio_chip_cdev = None;
+                for (const auto& fn : os_listdir(gpio_chip_dir))
+                {
+                    if (!startswith(fn, "gpiochip"))
+                        continue;
+
+                    gpio_chip_cdev = "/dev/" + fn;
+                    break;
+                }
+                gpio_chip_cdevs[gpio_chip_name] = gpio_chip_cdev;
+
                 string gpio_chip_gpio_dir = gpio_chip_dir + "/gpio";
                 auto files = os_listdir(gpio_chip_gpio_dir);
                 for (const auto& fn : files)
@@ -726,23 +740,24 @@ namespace GPIO
 
             auto global_gpio_id_name = [&gpio_chip_base, &gpio_chip_ngpio](DictionaryLike chip_relative_ids,
                                                                            DictionaryLike gpio_names,
-                                                                           string gpio_chip_name) -> tuple<int, string>
+                                                                           string gpio_chip_name)
+                -> tuple<int, int, string>
             {
                 if (!is_in(gpio_chip_name, gpio_chip_ngpio))
-                    return {None, None};
+                    return {None, None, None};
 
                 auto chip_gpio_ngpio = gpio_chip_ngpio[gpio_chip_name];
 
-                auto chip_relative_id = chip_relative_ids.get(chip_gpio_ngpio);
+                auto chip_relative_id = stoi(strip(chip_relative_ids.get(chip_gpio_ngpio)));
 
-                auto gpio = gpio_chip_base[gpio_chip_name] + stoi(strip(chip_relative_id));
+                auto gpio = gpio_chip_base[gpio_chip_name] + chip_relative_id;
 
                 auto gpio_name = gpio_names.get(chip_gpio_ngpio);
 
                 if (is_None(gpio_name))
                     gpio_name = format("gpio%i", gpio);
 
-                return {gpio, gpio_name};
+                return {chip_relative_id, gpio, gpio_name};
             };
 
             set<string> pwm_chip_names{};
@@ -786,12 +801,14 @@ namespace GPIO
             }
 
             auto model_data =
-                [&global_gpio_id_name, &pwm_dirs, &gpio_chip_dirs](NumberingModes key, const auto& pin_defs)
+                [&global_gpio_id_name, &pwm_dirs, &gpio_chip_dirs, &gpio_chip_cdevs](NumberingModes key,
+                                                                                      const auto& pin_defs)
             {
                 auto get_or = [](const auto& dictionary, const string& x, const string& defaultValue) -> string
                 { return is_in(x, dictionary) ? dictionary.at(x) : defaultValue; };
 
-                map<string, ChannelInfo> ret{};
+                vector<ChannelInfo> ret{};
+                ret.reserve(pin_defs.size());
 
                 for (const auto& x : pin_defs)
                 {
@@ -801,19 +818,23 @@ namespace GPIO
                         throw std::runtime_error("[model_data]"s + x.SysfsDir + " is not in gpio_chip_dirs"s);
 
                     auto tmp = global_gpio_id_name(x.LinuxPin, x.ExportedName, x.SysfsDir);
-                    auto gpio = get<0>(tmp);
-                    auto gpio_name = get<1>(tmp);
-
-                    ret.insert({pinName, ChannelInfo{pinName, gpio_chip_dirs.at(x.SysfsDir), gpio, gpio_name,
-                                                     get_or(pwm_dirs, x.PWMSysfsDir, None), x.PWMID}});
+                    auto chip_gpio = get<0>(tmp);
+                    auto gpio = get<1>(tmp);
+                    auto gpio_name = get<2>(tmp);
+
+                    // the id is the index in pin_defs, so the same pin has the same id in every numbering mode
+                    int id = static_cast<int>(ret.size());
+                    ret.push_back(ChannelInfo{id, pinName, gpio_chip_dirs.at(x.SysfsDir), gpio_chip_cdevs.at(x.SysfsDir),
+                                              chip_gpio, gpio, gpio_name, get_or(pwm_dirs, x.PWMSysfsDir, None),
+                                              x.PWMID});
                 }
-                return ret;
+                return ChannelTable(move(ret));
             };
 
-            map<NumberingModes, map<string, ChannelInfo>> channel_data = {{BOARD, model_data(BOARD, pin_defs)},
-                                                                          {BCM, model_data(BCM, pin_defs)},
-                                                                          {CVM, model_data(CVM, pin_defs)},
-                                                                          {TEGRA_SOC, model_data(TEGRA_SOC, pin_defs)}};
+            map<NumberingModes, ChannelTable> channel_data = {{BOARD, model_data(BOARD, pin_defs)},
+                                                              {BCM, model_data(BCM, pin_defs)},
+                                                              {CVM, model_data(CVM, pin_defs)},
+                                                              {TEGRA_SOC, model_data(TEGRA_SOC, pin_defs)}};
 
             return {model, jetson_info, channel_data};
         }
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <set>
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/MainModule.h"
+
+namespace GPIO
+{
+    struct InputGroup::Impl
+    {
+        // pointers into the channel tables of MainModule, which live as long as the program
+        std::vector<const ChannelInfo*> _ch_infos;
+
+        template <class container_t> Impl(const container_t& channels)
+        {
+            try
+            {
+                if (channels.size() == 0 || channels.size() > 64)
+                    throw std::runtime_error("An InputGroup must have 1 to 64 channels");
+
+                std::set<int> ids{};
+                std::vector<ChannelInfo> members{};
+                for (const auto& channel : channels)
+                {
+                    const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+                    if (!ids.insert(ch_info.id).second)
+                        throw std::runtime_error("Channel " + ch_info.channel + " is given more than once");
+
+                    Directions direction = global()._app_channel_configuration(ch_info);
+                    if (direction != IN && direction != OUT)
+                        throw std::runtime_error("You must setup() the GPIO channel first: channel " +
+                                                 ch_info.channel);
+
+                    _ch_infos.push_back(&ch_info);
+                    members.push_back(ch_info);
+                }
+
+                global()._group(members);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "InputGroup::InputGroup()");
+            }
+        }
+
+        uint64_t read() const
+        {
+            try
+            {
+                return global()._input_many(_ch_infos.data(), _ch_infos.size());
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "InputGroup::read()");
+            }
+        }
+    };
+
+    InputGroup::InputGroup(const std::vector<std::string>& channels) : pImpl(std::make_unique<Impl>(channels)) {}
+    InputGroup::InputGroup(const std::vector<int>& channels) : pImpl(std::make_unique<Impl>(channels)) {}
+    InputGroup::InputGroup(const std::initializer_list<int>& channels) : pImpl(std::make_unique<Impl>(channels)) {}
+    InputGroup::~InputGroup() = default;
+
+    // move construct & assign
+    InputGroup::InputGroup(InputGroup&& other) = default;
+    InputGroup& InputGroup::operator=(InputGroup&& other) = default;
+
+    uint64_t InputGroup::read() const { return pImpl->read(); }
+
+    size_t InputGroup::size() const { return pImpl->_ch_infos.size(); }
+
+    const std::string& InputGroup::channel(size_t i) const { return pImpl->_ch_infos.at(i)->channel; }
+
+} // namespace GPIO
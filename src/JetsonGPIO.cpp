@@ -43,6 +43,7 @@ DEALINGS IN THE SOFTWARE.
 #include "private/MainModule.h"
 #include "private/Model.h"
 #include "private/ModelUtility.h"
+#include "private/MonotonicClock.h"
 #include "private/PythonFunctions.h"
 #include "private/SysfsRoot.h"
 
@@ -76,7 +77,9 @@ namespace GPIO
             }
             else // not set yet
             {
-                global()._channel_data = global()._channel_data_by_mode.at(mode);
+                const ChannelTable& table = global()._channel_data_by_mode.at(mode);
+                global()._backend->check_permission(table);
+                global()._channel_data = &table;
                 global()._gpio_mode = mode;
             }
         }
@@ -88,18 +91,37 @@ namespace GPIO
 
     NumberingModes getmode() { return global()._gpio_mode; }
 
-    void setup(const std::string& channel, Directions direction, int initial)
+    void setbackend(Backends backend)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            if (global()._gpio_mode != NumberingModes::None)
+                throw std::runtime_error("The backend must be set before setmode()");
+
+            if (backend != global()._backend->type())
+                global()._backend = make_backend(backend);
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "setbackend()");
+        }
+    }
+
+    Backends getbackend() { return global()._backend->type(); }
+
+    // channel_t: int or std::string. int channels are resolved without converting them into strings.
+    template <class channel_t> void _setup(const channel_t& channel, Directions direction, int initial)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
             if (global()._gpio_warnings)
             {
-                Directions sysfs_cfg = global()._sysfs_channel_configuration(ch_info);
+                Directions system_cfg = global()._system_channel_configuration(ch_info);
                 Directions app_cfg = global()._app_channel_configuration(ch_info);
 
-                if (app_cfg == UNKNOWN && sysfs_cfg != UNKNOWN)
+                if (app_cfg == UNKNOWN && system_cfg != UNKNOWN)
                 {
                     std::cerr
                         << "[WARNING] This channel is already in use, continuing anyway. Use setwarnings(false) to "
@@ -108,7 +130,7 @@ namespace GPIO
                 }
             }
 
-            if (is_in(ch_info.channel, global()._channel_configuration))
+            if (global()._app_channel_configuration(ch_info) != UNKNOWN)
                 global()._cleanup_one(ch_info);
 
             if (direction == OUT)
@@ -130,7 +152,19 @@ namespace GPIO
         }
     }
 
-    void setup(int channel, Directions direction, int initial) { setup(std::to_string(channel), direction, initial); }
+    template <class channel_t>
+    void _setup(const std::vector<channel_t>& channels, Directions direction, const std::vector<int>& initials)
+    {
+        if (direction == Directions::OUT && channels.size() != initials.size())
+            throw std::runtime_error(format("Number of values (%d) != number of channels (%d)", initials.size(), channels.size()));
+
+        for (std::size_t i = 0; i < channels.size(); i++)
+            _setup(channels[i], direction, initials[i]);    
+    }
+
+    void setup(const std::string& channel, Directions direction, int initial) { _setup(channel, direction, initial); }
+
+    void setup(int channel, Directions direction, int initial) { _setup(channel, direction, initial); }
 
     void setup(const std::vector<std::string>& channels, Directions direction, int initial)
     {
@@ -151,20 +185,12 @@ namespace GPIO
 
     void setup(const std::vector<std::string>& channels, Directions direction, const std::vector<int>& initials)
     {
-        if (direction == Directions::OUT && channels.size() != initials.size())
-            throw std::runtime_error(format("Number of values (%d) != number of channels (%d)", initials.size(), channels.size()));
-
-        for (std::size_t i = 0; i < channels.size(); i++)
-            setup(channels[i], direction, initials[i]);    
+        _setup(channels, direction, initials);
     }
 
     void setup(const std::vector<int>& channels, Directions direction, const std::vector<int>& initials)
     {
-        std::vector<std::string> _channels(channels.size());
-        std::transform(channels.begin(), channels.end(), _channels.begin(),
-                       [](int value) { return std::to_string(value); });
-
-        setup(_channels, direction, initials);
+        _setup(channels, direction, initials);
     }
 
     void setup(const std::initializer_list<int>& channels, Directions direction, const std::vector<int>& initials)
@@ -187,7 +213,7 @@ namespace GPIO
         }
     }
 
-    void cleanup(const std::vector<std::string>& channels)
+    template <class channel_t> void _cleanup(const std::vector<channel_t>& channels)
     {
         try
         {
@@ -196,7 +222,7 @@ namespace GPIO
             auto ch_infos = global()._channels_to_infos(channels);
             for (auto&& ch_info : ch_infos)
             {
-                if (is_in(ch_info.channel, global()._channel_configuration))
+                if (global()._app_channel_configuration(ch_info) != UNKNOWN)
                 {
                     global()._cleanup_one(ch_info);
                 }
@@ -208,39 +234,28 @@ namespace GPIO
         }
     }
 
-    void cleanup(const std::vector<int>& channels)
-    {
-        std::vector<std::string> _channels(channels.size());
-        std::transform(channels.begin(), channels.end(), _channels.begin(),
-                       [](int value) { return std::to_string(value); });
-        cleanup(_channels);
-    }
+    void cleanup(const std::vector<std::string>& channels) { _cleanup(channels); }
+
+    void cleanup(const std::vector<int>& channels) { _cleanup(channels); }
 
     void cleanup(const std::string& channel) { cleanup(std::vector<std::string>{channel}); }
 
-    void cleanup(int channel)
-    {
-        std::string str_channel = std::to_string(channel);
-        cleanup(str_channel);
-    }
+    void cleanup(int channel) { cleanup(std::vector<int>{channel}); }
 
     void cleanup(const std::initializer_list<int>& channels) { cleanup(std::vector<int>(channels)); }
 
-    int input(const std::string& channel)
+    template <class channel_t> int _input(const channel_t& channel)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
             Directions app_cfg = global()._app_channel_configuration(ch_info);
 
             if (app_cfg != IN && app_cfg != OUT)
                 throw std::runtime_error("You must setup() the GPIO channel first");
 
-            ch_info.f_value->seekg(0, std::ios::beg);
-            int value_read{};
-            *ch_info.f_value >> value_read;
-            return value_read;
+            return global()._input_one(ch_info);
         }
         catch (std::exception& e)
         {
@@ -248,15 +263,50 @@ namespace GPIO
         }
     }
 
-    int input(int channel) { return input(std::to_string(channel)); }
+    int input(const std::string& channel) { return _input(channel); }
 
-    /* Function used to set a value to a channel.
-       Values must be either HIGH or LOW */
-    void output(const std::string& channel, int value)
+    int input(int channel) { return _input(channel); }
+
+    // container_t: a container of int or std::string channels (std::vector, std::initializer_list)
+    template <class container_t> uint64_t _input_all(const container_t& channels)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            if (channels.size() > 64)
+                throw std::runtime_error("Can't read more than 64 channels at once");
+
+            const ChannelInfo* ch_infos[64];
+            size_t i = 0;
+            for (const auto& channel : channels)
+            {
+                const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+                Directions app_cfg = global()._app_channel_configuration(ch_info);
+                if (app_cfg != IN && app_cfg != OUT)
+                    throw std::runtime_error("You must setup() the GPIO channel first");
+
+                ch_infos[i++] = &ch_info;
+            }
+
+            return global()._input_many(ch_infos, channels.size());
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "input()");
+        }
+    }
+
+    uint64_t input(const std::vector<std::string>& channels) { return _input_all(channels); }
+
+    uint64_t input(const std::vector<int>& channels) { return _input_all(channels); }
+
+    uint64_t input(const std::initializer_list<int>& channels) { return _input_all(channels); }
+
+    template <class channel_t> void _output(const channel_t& channel, int value)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
             // check that the channel has been set as output
             if (global()._app_channel_configuration(ch_info) != OUT)
                 throw std::runtime_error("The GPIO channel has not been set up as an OUTPUT");
@@ -268,7 +318,20 @@ namespace GPIO
         }
     }
 
-    void output(int channel, int value) { output(std::to_string(channel), value); }
+    template <class channel_t> void _output(const std::vector<channel_t>& channels, const std::vector<int>& values)
+    {
+        if (channels.size() != values.size())
+            throw std::runtime_error(format("Number of values (%d) != number of channels (%d)", values.size(), channels.size()));
+
+        for (std::size_t i = 0; i < channels.size(); i++)
+            _output(channels[i], values[i]);
+    }
+
+    /* Function used to set a value to a channel.
+       Values must be either HIGH or LOW */
+    void output(const std::string& channel, int value) { _output(channel, value); }
+
+    void output(int channel, int value) { _output(channel, value); }
 
     void output(const std::vector<std::string>& channels, int value)
     {
@@ -287,11 +350,7 @@ namespace GPIO
 
     void output(const std::vector<std::string>& channels, const std::vector<int>& values)
     {
-        if (channels.size() != values.size())
-            throw std::runtime_error(format("Number of values (%d) != number of channels (%d)", values.size(), channels.size()));
-
-        for (std::size_t i = 0; i < channels.size(); i++)
-            output(channels[i], values[i]);
+        _output(channels, values);
     }
 
     void output(const std::initializer_list<int>& channels, const std::vector<int>& values)
@@ -299,19 +358,54 @@ namespace GPIO
         output(std::vector<int>(channels), values);
     }
 
-    void output(const std::vector<int>& channels, const std::vector<int>& values)
+    void output(const std::vector<int>& channels, const std::vector<int>& values) { _output(channels, values); }
+
+    template <class channel_t> void _toggle(const channel_t& channel)
     {
-        std::vector<std::string> _channels(channels.size());
-        std::transform(channels.begin(), channels.end(), _channels.begin(), [](int x){ return std::to_string(x); });
-        output(_channels, values);
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+            if (global()._app_channel_configuration(ch_info) != OUT)
+                throw std::runtime_error("The GPIO channel has not been set up as an OUTPUT");
+            global()._toggle_one(ch_info);
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "toggle()");
+        }
     }
 
-    Directions gpio_function(const std::string& channel)
+    void toggle(const std::string& channel) { _toggle(channel); }
+
+    void toggle(int channel) { _toggle(channel); }
+
+    void setoutputcache(bool state) { global()._output_cache = state; }
+
+    OutputStats output_stats() { return global()._output_stats_total; }
+
+    template <class channel_t> OutputStats _output_stats(const channel_t& channel)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel);
-            return global()._sysfs_channel_configuration(ch_info);
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+            return global()._output_stats[ch_info.id];
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "output_stats()");
+        }
+    }
+
+    OutputStats output_stats(const std::string& channel) { return _output_stats(channel); }
+
+    OutputStats output_stats(int channel) { return _output_stats(channel); }
+
+    template <class channel_t> Directions _gpio_function(const channel_t& channel)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel);
+            return global()._system_channel_configuration(ch_info);
         }
         catch (std::exception& e)
         {
@@ -319,13 +413,15 @@ namespace GPIO
         }
     }
 
-    Directions gpio_function(int channel) { return gpio_function(std::to_string(channel)); }
+    Directions gpio_function(const std::string& channel) { return _gpio_function(channel); }
+
+    Directions gpio_function(int channel) { return _gpio_function(channel); }
 
     //=============================== Events =================================
 
-    bool event_detected(const std::string& channel)
+    template <class channel_t> bool _event_detected(const channel_t& channel)
     {
-        ChannelInfo ch_info = global()._channel_to_info(channel, true);
+        const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
         try
         {
             // channel must be setup as input
@@ -341,9 +437,11 @@ namespace GPIO
         }
     }
 
-    bool event_detected(int channel) { return event_detected(std::to_string(channel)); }
+    bool event_detected(const std::string& channel) { return _event_detected(channel); }
 
-    void add_event_callback(const std::string& channel, const Callback& callback)
+    bool event_detected(int channel) { return _event_detected(channel); }
+
+    template <class channel_t> void _add_event_callback(const channel_t& channel, const Callback& callback)
     {
         try
         {
@@ -353,7 +451,7 @@ namespace GPIO
                 throw std::invalid_argument("callback cannot be null");
             }
 
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
             // channel must be setup as input
             Directions app_cfg = global()._app_channel_configuration(ch_info);
@@ -385,28 +483,33 @@ namespace GPIO
         }
     }
 
-    void add_event_callback(int channel, const Callback& callback)
+    void add_event_callback(const std::string& channel, const Callback& callback)
     {
-        add_event_callback(std::to_string(channel), callback);
+        _add_event_callback(channel, callback);
     }
 
-    void remove_event_callback(const std::string& channel, const Callback& callback)
+    void add_event_callback(int channel, const Callback& callback) { _add_event_callback(channel, callback); }
+
+    template <class channel_t> void _remove_event_callback(const channel_t& channel, const Callback& callback)
     {
-        ChannelInfo ch_info = global()._channel_to_info(channel, true);
+        const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
         _remove_edge_callback(ch_info.gpio, callback);
     }
 
-    void remove_event_callback(int channel, const Callback& callback)
+    void remove_event_callback(const std::string& channel, const Callback& callback)
     {
-        remove_event_callback(std::to_string(channel), callback);
+        _remove_event_callback(channel, callback);
     }
 
-    void add_event_detect(const std::string& channel, Edge edge, const Callback& callback, unsigned long bounce_time)
+    void remove_event_callback(int channel, const Callback& callback) { _remove_event_callback(channel, callback); }
+
+    template <class channel_t>
+    void _add_event_detect(const channel_t& channel, Edge edge, const Callback& callback, unsigned long bounce_time)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
             // channel must be setup as input
             Directions app_cfg = global()._app_channel_configuration(ch_info);
@@ -421,7 +524,7 @@ namespace GPIO
 
             // Execute
             EventResultCode result =
-                (EventResultCode)_add_edge_detect(ch_info.gpio, ch_info.gpio_name, channel, edge, bounce_time);
+                (EventResultCode)_add_edge_detect(global()._backend, ch_info, edge, bounce_time);
             switch (result)
             {
             case EventResultCode::None:
@@ -446,25 +549,212 @@ namespace GPIO
         }
     }
 
+    void add_event_detect(const std::string& channel, Edge edge, const Callback& callback, unsigned long bounce_time)
+    {
+        _add_event_detect(channel, edge, callback, bounce_time);
+    }
+
     void add_event_detect(int channel, Edge edge, const Callback& callback, unsigned long bounce_time)
     {
-        return add_event_detect(std::to_string(channel), edge, callback, bounce_time);
+        _add_event_detect(channel, edge, callback, bounce_time);
     }
 
-    void remove_event_detect(const std::string& channel)
+    template <class channel_t> void _remove_event_detect(const channel_t& channel)
     {
-        ChannelInfo ch_info = global()._channel_to_info(channel, true);
+        const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
         _remove_edge_detect(ch_info.gpio);
+        global()._update_reflex_outputs();
     }
 
-    void remove_event_detect(int channel) { remove_event_detect(std::to_string(channel)); }
+    void remove_event_detect(const std::string& channel) { _remove_event_detect(channel); }
 
-    WaitResult wait_for_edge(const std::string& channel, Edge edge, uint64_t bounce_time, uint64_t timeout)
+    void remove_event_detect(int channel) { _remove_event_detect(channel); }
+
+    template <class channel_t> void _set_glitch_filter(const channel_t& channel, unsigned long window_us)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            EventResultCode result = (EventResultCode)_set_glitch_filter(ch_info, (uint64_t)window_us * 1000);
+            switch (result)
+            {
+            case EventResultCode::None:
+                break;
+            case EventResultCode::GPIO_Event_Not_Found:
+                throw std::runtime_error("The edge event must have been set via add_event_detect()");
+            default:
+            {
+                const char* error_msg = event_error_code_to_message[result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            }
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "set_glitch_filter()");
+        }
+    }
+
+    void set_glitch_filter(const std::string& channel, unsigned long window_us)
+    {
+        _set_glitch_filter(channel, window_us);
+    }
+
+    void set_glitch_filter(int channel, unsigned long window_us) { _set_glitch_filter(channel, window_us); }
+
+    template <class channel_t>
+    void _add_reflex(const channel_t& input_channel, Edge edge, const channel_t& output_channel, int value)
+    {
+        try
+        {
+            const ChannelInfo& input = global()._channel_to_info(input_channel, true);
+            const ChannelInfo& output = global()._channel_to_info(output_channel, true);
+            if (global()._app_channel_configuration(output) != OUT)
+                throw std::runtime_error("The output GPIO channel has not been set up as an OUTPUT");
+            if (value != HIGH && value != LOW && value != TOGGLE)
+                throw std::runtime_error("value must be HIGH, LOW or TOGGLE");
+
+            EventResultCode result = (EventResultCode)_add_reflex(input, edge, output, value == TOGGLE ? -1 : value);
+            switch (result)
+            {
+            case EventResultCode::None:
+                break;
+            case EventResultCode::GPIO_Event_Not_Found:
+                throw std::runtime_error("The edge event must have been set via add_event_detect()");
+            case EventResultCode::IllegalEdgeArgument:
+                throw std::runtime_error("edge must be RISING, FALLING or BOTH");
+            default:
+            {
+                const char* error_msg = event_error_code_to_message[result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            }
+
+            // the reflex writes it in the event thread from now on
+            global()._update_reflex_outputs();
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "add_reflex()");
+        }
+    }
+
+    void add_reflex(const std::string& input_channel, Edge edge, const std::string& output_channel, int value)
+    {
+        _add_reflex(input_channel, edge, output_channel, value);
+    }
+
+    void add_reflex(int input_channel, Edge edge, int output_channel, int value)
+    {
+        _add_reflex(input_channel, edge, output_channel, value);
+    }
+
+    template <class channel_t> void _remove_reflexes(const channel_t& channel)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+            _clear_reflexes(ch_info.gpio);
+            global()._update_reflex_outputs();
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "remove_reflexes()");
+        }
+    }
+
+    void remove_reflexes(const std::string& channel) { _remove_reflexes(channel); }
+
+    void remove_reflexes(int channel) { _remove_reflexes(channel); }
+
+    template <class channel_t> void _set_event_buffer(const channel_t& channel, size_t size)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            EventResultCode result = (EventResultCode)_set_event_buffer(ch_info.gpio, size);
+            switch (result)
+            {
+            case EventResultCode::None:
+                break;
+            case EventResultCode::GPIO_Event_Not_Found:
+                throw std::runtime_error("The edge event must have been set via add_event_detect()");
+            default:
+            {
+                const char* error_msg = event_error_code_to_message[result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            }
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "set_event_buffer()");
+        }
+    }
+
+    void set_event_buffer(const std::string& channel, size_t size) { _set_event_buffer(channel, size); }
+
+    void set_event_buffer(int channel, size_t size) { _set_event_buffer(channel, size); }
+
+    template <class channel_t> size_t _read_events(const channel_t& channel, EdgeEvent* events, size_t max)
     {
         try
         {
-            ChannelInfo ch_info = global()._channel_to_info(channel, true);
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            auto buffer = _event_buffer(ch_info.gpio);
+            if (buffer == nullptr)
+                throw std::runtime_error("The event buffer must have been set via set_event_buffer()");
+
+            return buffer->pop(events, max);
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "read_events()");
+        }
+    }
+
+    size_t read_events(const std::string& channel, EdgeEvent* events, size_t max)
+    {
+        return _read_events(channel, events, max);
+    }
+
+    size_t read_events(int channel, EdgeEvent* events, size_t max) { return _read_events(channel, events, max); }
+
+    template <class channel_t> EventBufferStats _event_buffer_stats(const channel_t& channel)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            EventBufferStats stats{};
+            auto buffer = _event_buffer(ch_info.gpio);
+            if (buffer != nullptr)
+            {
+                stats.capacity = buffer->capacity();
+                stats.queued = buffer->size();
+                stats.overflows = buffer->overflows();
+            }
+            return stats;
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "event_buffer_stats()");
+        }
+    }
+
+    EventBufferStats event_buffer_stats(const std::string& channel) { return _event_buffer_stats(channel); }
+
+    EventBufferStats event_buffer_stats(int channel) { return _event_buffer_stats(channel); }
+
+    template <class channel_t> void _add_pulse_counter(const channel_t& channel, Edge edge)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
 
             // channel must be setup as input
             Directions app_cfg = global()._app_channel_configuration(ch_info);
@@ -478,8 +768,135 @@ namespace GPIO
                 throw std::invalid_argument("argument 'edge' must be set to RISING, FALLING or BOTH");
 
             // Execute
-            EventResultCode result = (EventResultCode)_blocking_wait_for_edge(ch_info.gpio, ch_info.gpio_name, channel,
-                                                                              edge, bounce_time, timeout);
+            EventResultCode result = (EventResultCode)_add_pulse_counter(global()._backend, ch_info, edge);
+            switch (result)
+            {
+            case EventResultCode::None:
+                break;
+            default:
+            {
+                const char* error_msg = event_error_code_to_message[result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            }
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "add_pulse_counter()");
+        }
+    }
+
+    void add_pulse_counter(const std::string& channel, Edge edge) { _add_pulse_counter(channel, edge); }
+
+    void add_pulse_counter(int channel, Edge edge) { _add_pulse_counter(channel, edge); }
+
+    template <class channel_t> PulseCount _pulse_count(const channel_t& channel)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            auto counter = _pulse_counter(ch_info.gpio);
+            if (counter == nullptr)
+                throw std::runtime_error("The pulse counter must have been set via add_pulse_counter()");
+
+            return counter->read(_monotonic_ns());
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "pulse_count()");
+        }
+    }
+
+    PulseCount pulse_count(const std::string& channel) { return _pulse_count(channel); }
+
+    PulseCount pulse_count(int channel) { return _pulse_count(channel); }
+
+    void setcallbackworkers(unsigned workers)
+    {
+        try
+        {
+            _set_callback_workers(workers);
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "setcallbackworkers()");
+        }
+    }
+
+    void setcallbackqueuesize(size_t size)
+    {
+        try
+        {
+            _set_callback_queue_size(size);
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "setcallbackqueuesize()");
+        }
+    }
+
+    CallbackStats callback_stats() { return _callback_stats(); }
+
+    EventStats event_stats() { return _event_stats(); }
+
+    int event_fd()
+    {
+        try
+        {
+            int result = _event_fd();
+            if (result < 0)
+            {
+                const char* error_msg = event_error_code_to_message[(EventResultCode)result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            return result;
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "event_fd()");
+        }
+    }
+
+    int process_events()
+    {
+        try
+        {
+            int result = _process_events();
+            if (result < 0)
+            {
+                const char* error_msg = event_error_code_to_message[(EventResultCode)result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            return result;
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "process_events()");
+        }
+    }
+
+    template <class channel_t>
+    WaitResult _wait_for_edge(const channel_t& channel, Edge edge, uint64_t bounce_time, uint64_t timeout)
+    {
+        try
+        {
+            const ChannelInfo& ch_info = global()._channel_to_info(channel, true);
+
+            // channel must be setup as input
+            Directions app_cfg = global()._app_channel_configuration(ch_info);
+            if (app_cfg != Directions::IN)
+            {
+                throw std::runtime_error("You must setup() the GPIO channel as an input first");
+            }
+
+            // edge provided must be rising, falling or both
+            if (edge != Edge::RISING && edge != Edge::FALLING && edge != Edge::BOTH)
+                throw std::invalid_argument("argument 'edge' must be set to RISING, FALLING or BOTH");
+
+            // Execute
+            EventResultCode result =
+                (EventResultCode)_blocking_wait_for_edge(global()._backend, ch_info, edge, bounce_time, timeout);
             switch (result)
             {
             case EventResultCode::None:
@@ -487,7 +904,7 @@ namespace GPIO
                 return (std::string)None;
             case EventResultCode::EdgeDetected:
                 // Event Detected
-                return channel;
+                return ch_info.channel;
             default:
             {
                 const char* error_msg = event_error_code_to_message[result];
@@ -501,8 +918,76 @@ namespace GPIO
         }
     }
 
+    WaitResult wait_for_edge(const std::string& channel, Edge edge, uint64_t bounce_time, uint64_t timeout)
+    {
+        return _wait_for_edge(channel, edge, bounce_time, timeout);
+    }
+
     WaitResult wait_for_edge(int channel, Edge edge, uint64_t bounce_time, uint64_t timeout)
     {
-        return wait_for_edge(std::to_string(channel), edge, bounce_time, timeout);
+        return _wait_for_edge(channel, edge, bounce_time, timeout);
+    }
+
+    template <class channel_t>
+    std::vector<EdgeEvent> _wait_for_edges(const std::vector<channel_t>& channels, Edge edge, uint64_t bounce_time,
+                                           uint64_t timeout)
+    {
+        try
+        {
+            auto ch_infos = global()._channels_to_infos(channels, true);
+            if (ch_infos.empty())
+                throw std::invalid_argument("channels must not be empty");
+
+            std::set<int> gpios{};
+            for (const auto& ch_info : ch_infos)
+            {
+                // channels must be setup as input
+                Directions app_cfg = global()._app_channel_configuration(ch_info);
+                if (app_cfg != Directions::IN)
+                {
+                    throw std::runtime_error("You must setup() the GPIO channel " + ch_info.channel +
+                                             " as an input first");
+                }
+
+                if (!gpios.insert(ch_info.gpio).second)
+                    throw std::invalid_argument("channel " + ch_info.channel + " is given more than once");
+            }
+
+            // edge provided must be rising, falling or both
+            if (edge != Edge::RISING && edge != Edge::FALLING && edge != Edge::BOTH)
+                throw std::invalid_argument("argument 'edge' must be set to RISING, FALLING or BOTH");
+
+            // Execute
+            std::vector<EdgeEvent> detected{};
+            EventResultCode result = (EventResultCode)_blocking_wait_for_edges(global()._backend, ch_infos, edge,
+                                                                               bounce_time, timeout, detected);
+            switch (result)
+            {
+            case EventResultCode::None:
+            case EventResultCode::EdgeDetected:
+                return detected;
+            default:
+            {
+                const char* error_msg = event_error_code_to_message[result];
+                throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+            }
+            }
+        }
+        catch (std::exception& e)
+        {
+            throw _error(e, "wait_for_edges()");
+        }
+    }
+
+    std::vector<EdgeEvent> wait_for_edges(const std::vector<std::string>& channels, Edge edge, uint64_t bounce_time,
+                                          uint64_t timeout)
+    {
+        return _wait_for_edges(channels, edge, bounce_time, timeout);
+    }
+
+    std::vector<EdgeEvent> wait_for_edges(const std::vector<int>& channels, Edge edge, uint64_t bounce_time,
+                                          uint64_t timeout)
+    {
+        return _wait_for_edges(channels, edge, bounce_time, timeout);
     }
 } // namespace GPIO
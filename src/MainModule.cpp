@@ -32,7 +32,6 @@ DEALINGS IN THE SOFTWARE.
 #include "private/GPIOEvent.h"
 #include "private/MainModule.h"
 #include "private/ModelUtility.h"
-#include "private/SysfsRoot.h"
 
 using namespace std;
 
@@ -43,11 +42,6 @@ namespace GPIO
     // All global variables are wrapped in a singleton class except for public APIs,
     // in order to avoid initialization order problem among global variables in
     // different compilation units.
-    string MainModule::_gpio_dir(const ChannelInfo& ch_info)
-    {
-        return format("%s/%s", _SYSFS_ROOT, ch_info.gpio_name.c_str());
-    }
-
     MainModule::~MainModule()
     {
         try
@@ -76,19 +70,40 @@ namespace GPIO
                 "GPIO::setmode(GPIO::CVM)");
     }
 
-    ChannelInfo MainModule::_channel_to_info_lookup(const string& channel, bool need_gpio, bool need_pwm)
+    // the channel number is converted to a string only to build an error message
+    const string& _channel_name(const string& channel) { return channel; }
+    string _channel_name(int channel) { return to_string(channel); }
+
+    template <class channel_t>
+    const ChannelInfo& _lookup(const ChannelTable& table, const channel_t& channel, bool need_gpio, bool need_pwm)
+    {
+        const ChannelInfo* ch_info = table.find(channel);
+        if (ch_info == nullptr)
+            throw runtime_error("Channel " + _channel_name(channel) + " is invalid");
+        if (need_gpio && is_None(ch_info->gpio_chip_dir))
+            throw runtime_error("Channel " + _channel_name(channel) + " is not a GPIO");
+        if (need_pwm && is_None(ch_info->pwm_chip_dir))
+            throw runtime_error("Channel " + _channel_name(channel) + " is not a PWM");
+        return *ch_info;
+    }
+
+    const ChannelInfo& MainModule::_channel_to_info_lookup(const string& channel, bool need_gpio, bool need_pwm)
+    {
+        return _lookup(*_channel_data, channel, need_gpio, need_pwm);
+    }
+
+    const ChannelInfo& MainModule::_channel_to_info_lookup(int channel, bool need_gpio, bool need_pwm)
     {
-        if (!is_in(channel, _channel_data))
-            throw runtime_error("Channel " + channel + " is invalid");
-        ChannelInfo ch_info = _channel_data.at(channel);
-        if (need_gpio && is_None(ch_info.gpio_chip_dir))
-            throw runtime_error("Channel " + channel + " is not a GPIO");
-        if (need_pwm && is_None(ch_info.pwm_chip_dir))
-            throw runtime_error("Channel " + channel + " is not a PWM");
-        return ch_info;
+        return _lookup(*_channel_data, channel, need_gpio, need_pwm);
     }
 
-    ChannelInfo MainModule::_channel_to_info(const string& channel, bool need_gpio, bool need_pwm)
+    const ChannelInfo& MainModule::_channel_to_info(const string& channel, bool need_gpio, bool need_pwm)
+    {
+        _validate_mode_set();
+        return _channel_to_info_lookup(channel, need_gpio, need_pwm);
+    }
+
+    const ChannelInfo& MainModule::_channel_to_info(int channel, bool need_gpio, bool need_pwm)
     {
         _validate_mode_set();
         return _channel_to_info_lookup(channel, need_gpio, need_pwm);
@@ -105,7 +120,18 @@ namespace GPIO
         return ch_infos;
     }
 
-    Directions MainModule::_sysfs_channel_configuration(const ChannelInfo& ch_info)
+    vector<ChannelInfo> MainModule::_channels_to_infos(const vector<int>& channels, bool need_gpio, bool need_pwm)
+    {
+        _validate_mode_set();
+        vector<ChannelInfo> ch_infos{};
+        for (const auto& c : channels)
+        {
+            ch_infos.push_back(_channel_to_info_lookup(c, need_gpio, need_pwm));
+        }
+        return ch_infos;
+    }
+
+    Directions MainModule::_system_channel_configuration(const ChannelInfo& ch_info)
     {
         if (!is_None(ch_info.pwm_chip_dir))
         {
@@ -114,101 +140,146 @@ namespace GPIO
                 return HARD_PWM;
         }
 
-        string gpio_dir = _gpio_dir(ch_info);
-        if (!os_path_exists(gpio_dir))
-            return UNKNOWN; // Originally returns None in NVIDIA's GPIO Python Library
+        return _backend->direction(ch_info);
+    }
 
-        string gpio_direction{};
-        { // scope for f
-            ifstream f_direction(format("%s/direction", gpio_dir.c_str()));
+    Directions MainModule::_app_channel_configuration(const ChannelInfo& ch_info)
+    {
+        // UNKNOWN originally returns None in NVIDIA's GPIO Python Library
+        return _channel_configuration[ch_info.id];
+    }
 
-            gpio_direction = read(f_direction);
-            gpio_direction = lower(strip(gpio_direction));
-        } // scope ends
+    void MainModule::_output_one(const ChannelInfo& ch_info, const int value)
+    {
+        int v = value ? 1 : 0;
+        int& shadow = _output_shadow[ch_info.id];
+        OutputStats& stats = _output_stats[ch_info.id];
+        stats.writes++;
+        _output_stats_total.writes++;
 
-        if (gpio_direction == "in")
-            return IN;
-        else if (gpio_direction == "out")
-            return OUT;
-        else
-            return UNKNOWN; // Originally returns None in NVIDIA's GPIO Python Library
+        if (_output_cache && shadow == v)
+        {
+            stats.elided++;
+            _output_stats_total.elided++;
+            return;
+        }
+
+        // unknown until the write succeeds
+        shadow = -1;
+        _backend->write(ch_info, v);
+        shadow = _reflex_output[ch_info.id] ? -1 : v;
     }
 
-    Directions MainModule::_app_channel_configuration(const ChannelInfo& ch_info)
+    void MainModule::_toggle_one(const ChannelInfo& ch_info)
     {
-        if (!is_in(ch_info.channel, _channel_configuration))
-            return UNKNOWN; // Originally returns None in NVIDIA's GPIO Python Library
-        return _channel_configuration[ch_info.channel];
+        int shadow = _output_shadow[ch_info.id];
+        int value = shadow < 0 ? _backend->read(ch_info) : shadow;
+        _output_one(ch_info, !value);
     }
 
-    void MainModule::_export_gpio(const ChannelInfo& ch_info)
+    uint64_t MainModule::_shadow_many(const vector<ChannelInfo>& ch_infos, uint64_t mask, uint64_t values)
     {
-        string gpio_dir = _gpio_dir(ch_info);
+        uint64_t changed = 0;
+        for (size_t i = 0; i < ch_infos.size(); i++)
+        {
+            if (!((mask >> i) & 1))
+                continue;
+
+            int v = (values >> i) & 1;
+            int& shadow = _output_shadow[ch_infos[i].id];
+            OutputStats& stats = _output_stats[ch_infos[i].id];
+            stats.writes++;
+            _output_stats_total.writes++;
+
+            if (_output_cache && shadow == v)
+            {
+                stats.elided++;
+                _output_stats_total.elided++;
+                continue;
+            }
+
+            changed |= 1ULL << i;
+            shadow = _reflex_output[ch_infos[i].id] ? -1 : v;
+        }
+        return changed;
+    }
 
-        if (!os_path_exists(gpio_dir))
-        { // scope for f_export
-            ofstream f_export(_export_dir());
-            f_export << ch_info.gpio;
-        } // scope ends
+    int MainModule::_input_one(const ChannelInfo& ch_info) { return _backend->read(ch_info); }
 
-        string value_path = format("%s/value", gpio_dir.c_str());
+    uint64_t MainModule::_input_many(const ChannelInfo* const* ch_infos, size_t count)
+    {
+        if (count > 64)
+            throw runtime_error("Can't read more than 64 channels at once");
 
-        int time_count = 0;
-        while (!os_access(value_path, R_OK | W_OK))
+        // fixed size arrays: nothing is allocated on this path
+        const LineRequest* requests[64];
+        uint64_t masks[64];
+        uint64_t bits[64];
+        unsigned request_of[64];
+        size_t request_count = 0;
+
+        for (size_t i = 0; i < count; i++)
         {
-            this_thread::sleep_for(chrono::milliseconds(10));
-            if (time_count++ > 100)
-                throw runtime_error("Permission denied: path: " + value_path +
-                                    "\n Please configure permissions or use the root user to run this.");
+            const GPIOLine& line = *ch_infos[i]->line;
+            if (line.request == nullptr)
+                throw runtime_error("You must setup() the GPIO channel first: channel " + ch_infos[i]->channel);
+
+            size_t r = 0;
+            while (r < request_count && requests[r] != line.request.get())
+                r++;
+            if (r == request_count)
+            {
+                requests[r] = line.request.get();
+                masks[r] = 0;
+                request_count++;
+            }
+            masks[r] |= 1ULL << line.index;
+            request_of[i] = r;
         }
 
-        ch_info.f_direction->open(format("%s/direction", gpio_dir.c_str()), std::ios::out);
-        ch_info.f_value->open(value_path, std::ios::in | std::ios::out);
+        for (size_t r = 0; r < request_count; r++)
+            bits[r] = _backend->read_lines(*requests[r], masks[r]);
+
+        uint64_t values = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if ((bits[request_of[i]] >> ch_infos[i]->line->index) & 1)
+                values |= 1ULL << i;
+        }
+        return values;
     }
 
-    void MainModule::_unexport_gpio(const ChannelInfo& ch_info)
+    void MainModule::_group(const vector<ChannelInfo>& ch_infos)
     {
-        ch_info.f_direction->close();
-        ch_info.f_value->close();
-        string gpio_dir = _gpio_dir(ch_info);
-
-        if (!os_path_exists(gpio_dir))
-            return;
-
-        ofstream f_unexport(_unexport_dir());
-        f_unexport << ch_info.gpio;
+        auto lock = _lock_line_requests();
+        auto soft_pwm_lock = _soft_pwm.lock_lines();
+        _backend->group(ch_infos);
     }
 
-    void MainModule::_output_one(const ChannelInfo& ch_info, const int value)
+    void MainModule::_update_reflex_outputs()
     {
-        ch_info.f_value->seekg(0, std::ios::beg);
-        *ch_info.f_value << static_cast<int>(static_cast<bool>(value));
-        ch_info.f_value->flush();
+        auto outputs = _reflex_outputs(_reflex_output.size());
+        for (size_t id = 0; id < outputs.size(); id++)
+        {
+            // the value of a channel written by a reflex is never known
+            if (outputs[id])
+                _output_shadow[id] = -1;
+            _reflex_output[id] = outputs[id];
+        }
     }
 
     void MainModule::_setup_single_out(const ChannelInfo& ch_info, int initial)
     {
-        _export_gpio(ch_info);
-
-        ch_info.f_direction->seekg(0, std::ios::beg);
-        *ch_info.f_direction << "out";
-        ch_info.f_direction->flush();
-
-        if (!is_None(initial))
-            _output_one(ch_info, initial);
-
-        _channel_configuration[ch_info.channel] = OUT;
+        _backend->setup_out(ch_info, initial);
+        _channel_configuration[ch_info.id] = OUT;
+        _output_shadow[ch_info.id] = is_None(initial) ? -1 : (initial ? 1 : 0);
+        _output_stats[ch_info.id] = OutputStats{};
     }
 
     void MainModule::_setup_single_in(const ChannelInfo& ch_info)
     {
-        _export_gpio(ch_info);
-
-        ch_info.f_direction->seekg(0, std::ios::beg);
-        *ch_info.f_direction << "in";
-        ch_info.f_direction->flush();
-
-        _channel_configuration[ch_info.channel] = IN;
+        _backend->setup_in(ch_info);
+        _channel_configuration[ch_info.id] = IN;
     }
 
     string MainModule::_pwm_path(const ChannelInfo& ch_info)
@@ -325,7 +396,7 @@ namespace GPIO
 
     void MainModule::_cleanup_one(const ChannelInfo& ch_info)
     {
-        Directions app_cfg = _channel_configuration[ch_info.channel];
+        Directions app_cfg = _channel_configuration[ch_info.id];
         if (app_cfg == HARD_PWM)
         {
             _disable_pwm(ch_info);
@@ -333,27 +404,32 @@ namespace GPIO
         }
         else
         {
-            _event_cleanup(ch_info.gpio, ch_info.gpio_name);
-            _unexport_gpio(ch_info);
+            _soft_pwm.remove_channel(ch_info.id);
+            // the reflexes writing the channel are removed first
+            _event_cleanup(ch_info.gpio);
+            _update_reflex_outputs();
+
+            // may request the other lines of a merged request again, which reflexes or SoftPWMs may write
+            auto lock = _lock_line_requests();
+            auto soft_pwm_lock = _soft_pwm.lock_lines();
+            _backend->release(ch_info);
         }
-        _channel_configuration.erase(ch_info.channel);
-    }
-
-    void MainModule::_cleanup_one(const std::string& channel)
-    {
-        ChannelInfo ch_info = _channel_to_info(channel);
-        _cleanup_one(ch_info);
+        _channel_configuration[ch_info.id] = UNKNOWN;
+        _output_shadow[ch_info.id] = -1;
     }
 
     void MainModule::_cleanup_all()
     {
-        auto copied = _channel_configuration;
-        for (const auto& _pair : copied)
+        if (_channel_data != nullptr)
         {
-            const auto& channel = _pair.first;
-            _cleanup_one(channel);
+            for (const auto& ch_info : *_channel_data)
+            {
+                if (_channel_configuration[ch_info.id] != UNKNOWN)
+                    _cleanup_one(ch_info);
+            }
         }
         _gpio_mode = NumberingModes::None;
+        _channel_data = nullptr;
     }
 
     const std::string& MainModule::model() const { return _model; }
@@ -377,21 +453,17 @@ namespace GPIO
       _model(model_name(_pinData.model)),
       _JETSON_INFO(_pinData.pin_info.JETSON_INFO()),
       _channel_data_by_mode(_pinData.channel_data),
+      _channel_data(nullptr),
       _gpio_warnings(true),
-      _gpio_mode(NumberingModes::None)
-    {
-        _check_permission();
-    }
-
-    void MainModule::_check_permission() const
+      _gpio_mode(NumberingModes::None),
+      _channel_configuration(_channel_data_by_mode.at(BOARD).size(), UNKNOWN),
+      _backend(make_backend(default_backend())),
+      _output_shadow(_channel_configuration.size(), -1),
+      _reflex_output(_channel_configuration.size(), false),
+      _output_stats(_channel_configuration.size()),
+      _output_stats_total(),
+      _output_cache(false)
     {
-        if (!os_access(_export_dir(), W_OK) || !os_access(_unexport_dir(), W_OK))
-        {
-            cerr << "[ERROR] The current user does not have permissions set to access the library functionalites. "
-                    "Please configure permissions or use the root user to run this."
-                 << endl;
-            throw runtime_error("Permission Denied.");
-        }
     }
 
 } // namespace GPIO
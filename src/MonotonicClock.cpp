@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/MonotonicClock.h"
+
+#include <time.h>
+
+#include <cerrno>
+#include <chrono>
+
+namespace GPIO
+{
+    namespace
+    {
+        // how long before the deadline _wait_until_ns() switches from the condition variable to clock_nanosleep
+        constexpr int64_t COARSE_WAIT_MARGIN_NS = 500000;
+    } // namespace
+
+    int64_t _monotonic_ns()
+    {
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    void _sleep_until_ns(int64_t deadline_ns)
+    {
+        timespec ts{};
+        ts.tv_sec = deadline_ns / 1000000000;
+        ts.tv_nsec = deadline_ns % 1000000000;
+
+        // clock_nanosleep returns the error number instead of setting errno
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+    }
+
+    bool _wait_until_ns(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, int64_t deadline_ns,
+                        const std::function<bool()>& interrupted)
+    {
+        while (deadline_ns - _monotonic_ns() > COARSE_WAIT_MARGIN_NS)
+        {
+            // std::chrono::steady_clock is CLOCK_MONOTONIC
+            auto wake_up =
+                std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline_ns - COARSE_WAIT_MARGIN_NS));
+            if (cv.wait_until(lock, wake_up, interrupted))
+                return false;
+        }
+
+        if (interrupted())
+            return false;
+
+        lock.unlock();
+        _sleep_until_ns(deadline_ns);
+        lock.lock();
+        return true;
+    }
+} // namespace GPIO
@@ -38,7 +38,7 @@ namespace GPIO
         double _duty_cycle_percent = 0;
         int _duty_cycle_ns = 0;
 
-        Impl(const std::string& channel, int frequency_hz) : _ch_info(global()._channel_to_info(channel, false, true))
+        Impl(const ChannelInfo& ch_info, int frequency_hz) : _ch_info(ch_info)
         {
             try
             {
@@ -51,20 +51,20 @@ namespace GPIO
                 allow HW PWM to run on the pin.
                 */
                 if (app_cfg == IN || app_cfg == OUT)
-                    cleanup(channel);
+                    global()._cleanup_one(_ch_info);
 
                 if (global()._gpio_warnings)
                 {
-                    auto sysfs_cfg = global()._sysfs_channel_configuration(_ch_info);
+                    auto system_cfg = global()._system_channel_configuration(_ch_info);
                     app_cfg = global()._app_channel_configuration(_ch_info);
 
                     // warn if channel has been setup external to current program
-                    if (app_cfg == UNKNOWN && sysfs_cfg != UNKNOWN)
+                    if (app_cfg == UNKNOWN && system_cfg != UNKNOWN)
                     {
                         std::cerr << "[WARNING] This channel is already in use, continuing "
                                      "anyway. "
                                      "Use setwarnings(false) to disable warnings. "
-                                  << "channel: " << channel << std::endl;
+                                  << "channel: " << _ch_info.channel << std::endl;
                     }
                 }
 
@@ -73,7 +73,7 @@ namespace GPIO
                 // Anything that doesn't match new frequency_hz
                 _frequency_hz = -1 * frequency_hz;
                 _reconfigure(frequency_hz, 0.0);
-                global()._channel_configuration[channel] = HARD_PWM;
+                global()._channel_configuration[_ch_info.id] = HARD_PWM;
             }
             catch (std::exception& e)
             {
@@ -81,12 +81,9 @@ namespace GPIO
             }
         }
 
-        Impl(int channel, int frequency_hz) : Impl(std::to_string(channel), frequency_hz) {}
-
         ~Impl()
         {
-            if (!is_in(_ch_info.channel, global()._channel_configuration) ||
-                global()._channel_configuration.at(_ch_info.channel) != HARD_PWM)
+            if (global()._channel_configuration[_ch_info.id] != HARD_PWM)
             {
                 /* The user probably ran cleanup() on the channel already, so avoid
                 attempts to repeat the cleanup operations. */
@@ -97,7 +94,7 @@ namespace GPIO
             {
                 stop();
                 global()._unexport_pwm(_ch_info);
-                global()._channel_configuration.erase(_ch_info.channel);
+                global()._channel_configuration[_ch_info.id] = UNKNOWN;
             }
             catch (std::exception& e)
             {
@@ -204,8 +201,15 @@ namespace GPIO
         }
     };
 
-    PWM::PWM(const std::string& channel, int frequency_hz) : pImpl(std::make_unique<Impl>(channel, frequency_hz)) {}
-    PWM::PWM(int channel, int frequency_hz) : pImpl(std::make_unique<Impl>(channel, frequency_hz)) {}
+    PWM::PWM(const std::string& channel, int frequency_hz)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, false, true), frequency_hz))
+    {
+    }
+
+    PWM::PWM(int channel, int frequency_hz)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, false, true), frequency_hz))
+    {
+    }
     PWM::~PWM() = default;
 
     // move construct & assign
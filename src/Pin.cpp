@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/MainModule.h"
+
+namespace GPIO
+{
+    struct Pin::Impl
+    {
+        ChannelInfo _ch_info;
+        Directions _direction;
+
+        Impl(const ChannelInfo& ch_info) : _ch_info(ch_info)
+        {
+            try
+            {
+                _direction = global()._app_channel_configuration(_ch_info);
+                if (_direction != IN && _direction != OUT)
+                    throw std::runtime_error("You must setup() the GPIO channel first");
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "Pin::Pin()");
+            }
+        }
+
+        void _check_output() const
+        {
+            if (_direction != OUT)
+                throw std::runtime_error("The GPIO channel has not been set up as an OUTPUT");
+        }
+
+        void write(int value)
+        {
+            try
+            {
+                _check_output();
+                global()._output_one(_ch_info, value);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "Pin::write()");
+            }
+        }
+
+        int read() const
+        {
+            try
+            {
+                return global()._input_one(_ch_info);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "Pin::read()");
+            }
+        }
+
+        void toggle()
+        {
+            try
+            {
+                _check_output();
+                global()._toggle_one(_ch_info);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "Pin::toggle()");
+            }
+        }
+    };
+
+    Pin::Pin(const std::string& channel) : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true))) {}
+    Pin::Pin(int channel) : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true))) {}
+    Pin::~Pin() = default;
+
+    // move construct & assign
+    Pin::Pin(Pin&& other) = default;
+    Pin& Pin::operator=(Pin&& other) = default;
+
+    void Pin::write(int value) { pImpl->write(value); }
+
+    int Pin::read() const { return pImpl->read(); }
+
+    void Pin::toggle() { pImpl->toggle(); }
+
+    const std::string& Pin::channel() const { return pImpl->_ch_info.channel; }
+
+    Directions Pin::direction() const { return pImpl->_direction; }
+
+} // namespace GPIO
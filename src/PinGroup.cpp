@@ -0,0 +1,217 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/MainModule.h"
+
+namespace GPIO
+{
+    struct PinGroup::Impl
+    {
+        // the members of the group that share a line request
+        struct Segment
+        {
+            std::weak_ptr<LineRequest> request;              // the request when the segment was built
+            std::shared_ptr<GPIOLine> line;                  // a line of the request
+            std::vector<std::pair<unsigned, unsigned>> bits; // (bit in the group, GPIOLine::index)
+        };
+
+        std::vector<ChannelInfo> _ch_infos;
+        uint64_t _out_mask;
+        std::shared_ptr<Backend> _backend;
+        std::vector<Segment> _segments;
+
+        Impl(const std::vector<ChannelInfo>& ch_infos) : _ch_infos(ch_infos), _out_mask(0)
+        {
+            try
+            {
+                if (_ch_infos.empty() || _ch_infos.size() > 64)
+                    throw std::runtime_error("A PinGroup must have 1 to 64 channels");
+
+                std::set<int> ids{};
+                for (size_t i = 0; i < _ch_infos.size(); i++)
+                {
+                    const auto& ch_info = _ch_infos[i];
+                    if (!ids.insert(ch_info.id).second)
+                        throw std::runtime_error("Channel " + ch_info.channel + " is given more than once");
+
+                    Directions direction = global()._app_channel_configuration(ch_info);
+                    if (direction != IN && direction != OUT)
+                        throw std::runtime_error("You must setup() the GPIO channel first: channel " +
+                                                 ch_info.channel);
+                    if (direction == OUT)
+                        _out_mask |= 1ULL << i;
+                }
+
+                _backend = global()._backend;
+                global()._group(_ch_infos);
+                _build_segments();
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "PinGroup::PinGroup()");
+            }
+        }
+
+        void _build_segments()
+        {
+            _segments.clear();
+            for (unsigned i = 0; i < _ch_infos.size(); i++)
+            {
+                const auto& line = _ch_infos[i].line;
+                if (line->request == nullptr)
+                    throw std::runtime_error("You must setup() the GPIO channel first: channel " +
+                                             _ch_infos[i].channel);
+
+                auto it = std::find_if(_segments.begin(), _segments.end(),
+                                       [&](const Segment& s) { return _same_request(s.request, line->request); });
+                if (it == _segments.end())
+                    it = _segments.insert(_segments.end(), Segment{line->request, line, {}});
+                it->bits.emplace_back(i, line->index);
+            }
+        }
+
+        // the backend may merge or split line requests (e.g. another PinGroup, add_event_detect())
+        void _update_segments()
+        {
+            for (const auto& segment : _segments)
+            {
+                for (const auto& bit : segment.bits)
+                {
+                    if (!_same_request(segment.request, _ch_infos[bit.first].line->request))
+                    {
+                        _build_segments();
+                        return;
+                    }
+                }
+            }
+        }
+
+        void write(uint64_t mask, uint64_t values)
+        {
+            try
+            {
+                uint64_t not_out = mask & ~_out_mask;
+                if (_ch_infos.size() < 64)
+                    not_out &= (1ULL << _ch_infos.size()) - 1;
+                if (not_out)
+                    throw std::runtime_error("The GPIO channel has not been set up as an OUTPUT: channel " +
+                                             _ch_infos[__builtin_ctzll(not_out)].channel);
+
+                // the output cache drops the channels that already have the value
+                mask = global()._shadow_many(_ch_infos, mask, values);
+                if (mask == 0)
+                    return;
+
+                _update_segments();
+                for (const auto& segment : _segments)
+                {
+                    uint64_t line_mask = 0;
+                    uint64_t line_bits = 0;
+                    for (const auto& bit : segment.bits)
+                    {
+                        if (!((mask >> bit.first) & 1))
+                            continue;
+
+                        line_mask |= 1ULL << bit.second;
+                        if ((values >> bit.first) & 1)
+                            line_bits |= 1ULL << bit.second;
+                    }
+
+                    if (line_mask)
+                        _backend->write_lines(*segment.line->request, line_mask, line_bits);
+                }
+            }
+            catch (std::exception& e)
+            {
+                // the values of the channels are unknown after a failure
+                for (size_t i = 0; i < _ch_infos.size(); i++)
+                {
+                    if ((mask >> i) & 1)
+                        global()._output_shadow[_ch_infos[i].id] = -1;
+                }
+                throw _error(e, "PinGroup::write()");
+            }
+        }
+
+        uint64_t read()
+        {
+            try
+            {
+                _update_segments();
+
+                uint64_t values = 0;
+                for (const auto& segment : _segments)
+                {
+                    uint64_t line_mask = 0;
+                    for (const auto& bit : segment.bits)
+                        line_mask |= 1ULL << bit.second;
+
+                    uint64_t line_bits = _backend->read_lines(*segment.line->request, line_mask);
+                    for (const auto& bit : segment.bits)
+                    {
+                        if ((line_bits >> bit.second) & 1)
+                            values |= 1ULL << bit.first;
+                    }
+                }
+                return values;
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "PinGroup::read()");
+            }
+        }
+    };
+
+    PinGroup::PinGroup(const std::vector<std::string>& channels)
+    : pImpl(std::make_unique<Impl>(global()._channels_to_infos(channels, true)))
+    {
+    }
+
+    PinGroup::PinGroup(const std::vector<int>& channels)
+    : pImpl(std::make_unique<Impl>(global()._channels_to_infos(channels, true)))
+    {
+    }
+
+    PinGroup::PinGroup(const std::initializer_list<int>& channels) : PinGroup(std::vector<int>(channels)) {}
+
+    PinGroup::~PinGroup() = default;
+
+    // move construct & assign
+    PinGroup::PinGroup(PinGroup&& other) = default;
+    PinGroup& PinGroup::operator=(PinGroup&& other) = default;
+
+    void PinGroup::write(uint64_t mask, uint64_t values) { pImpl->write(mask, values); }
+
+    uint64_t PinGroup::read() const { return pImpl->read(); }
+
+    size_t PinGroup::size() const { return pImpl->_ch_infos.size(); }
+
+    const std::string& PinGroup::channel(size_t i) const { return pImpl->_ch_infos.at(i).channel; }
+
+} // namespace GPIO
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <iostream>
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/GPIOEvent.h"
+#include "private/MainModule.h"
+#include "private/PulseCaptureSink.h"
+
+namespace GPIO
+{
+    struct PulseCapture::Impl
+    {
+        int _gpio;
+        std::shared_ptr<PulseCaptureSink> _sink;
+
+        Impl(const ChannelInfo& ch_info, size_t capacity) : _gpio(ch_info.gpio)
+        {
+            try
+            {
+                // channel must be setup as input
+                if (global()._app_channel_configuration(ch_info) != Directions::IN)
+                    throw std::runtime_error("You must setup() the GPIO channel as an input first");
+
+                _sink = std::make_shared<PulseCaptureSink>(capacity);
+
+                EventResultCode result =
+                    (EventResultCode)_add_edge_sink(global()._backend, ch_info, Edge::BOTH, _sink);
+                if (result != EventResultCode::None)
+                {
+                    const char* error_msg = event_error_code_to_message[result];
+                    throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+                }
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "PulseCapture::PulseCapture()");
+            }
+        }
+
+        // the channel may have been cleaned up (and set up again) since: only this capture is removed
+        ~Impl() { _remove_edge_sink(_gpio, _sink); }
+    };
+
+    PulseCapture::PulseCapture(const std::string& channel, size_t capacity)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true), capacity))
+    {
+    }
+
+    PulseCapture::PulseCapture(int channel, size_t capacity)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true), capacity))
+    {
+    }
+
+    PulseCapture::~PulseCapture() = default;
+
+    // move construct & assign
+    PulseCapture::PulseCapture(PulseCapture&& other) = default;
+    PulseCapture& PulseCapture::operator=(PulseCapture&& other) = default;
+
+    size_t PulseCapture::read(PulseMeasurement* measurements, size_t max)
+    {
+        return pImpl->_sink->read(measurements, max);
+    }
+
+    PulseCaptureStats PulseCapture::stats() const { return pImpl->_sink->stats(); }
+} // namespace GPIO
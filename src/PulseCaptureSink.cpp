@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/PulseCaptureSink.h"
+
+namespace GPIO
+{
+    namespace
+    {
+        // single writer: plain loads and stores are enough
+        void add_sample(std::atomic<unsigned long long>& count, std::atomic<uint64_t>& min, std::atomic<uint64_t>& max,
+                        std::atomic<uint64_t>& total, uint64_t value)
+        {
+            unsigned long long n = count.load(std::memory_order_relaxed);
+            if (n == 0 || value < min.load(std::memory_order_relaxed))
+                min.store(value, std::memory_order_relaxed);
+            if (value > max.load(std::memory_order_relaxed))
+                max.store(value, std::memory_order_relaxed);
+            total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            count.store(n + 1, std::memory_order_release);
+        }
+    } // namespace
+
+    PulseCaptureSink::PulseCaptureSink(size_t capacity) : _measurements(capacity) {}
+
+    void PulseCaptureSink::on_edge(int, Edge edge, int, uint64_t timestamp_ns)
+    {
+        if (edge == Edge::RISING)
+        {
+            _period_ns = _last_rise_ns != 0 && timestamp_ns > _last_rise_ns ? timestamp_ns - _last_rise_ns : 0;
+            if (_period_ns)
+                add_sample(_periods, _min_period_ns, _max_period_ns, _total_period_ns, _period_ns);
+
+            _last_rise_ns = timestamp_ns;
+            _high = true;
+        }
+        else if (edge == Edge::FALLING && _high)
+        {
+            // a falling edge without a rising edge before (e.g. the first edge) is not a pulse
+            _high = false;
+
+            PulseMeasurement measurement{};
+            measurement.rise_ns = _last_rise_ns;
+            measurement.width_ns = timestamp_ns > _last_rise_ns ? timestamp_ns - _last_rise_ns : 0;
+            measurement.period_ns = _period_ns;
+            _measurements.push(measurement);
+            add_sample(_pulses, _min_width_ns, _max_width_ns, _total_width_ns, measurement.width_ns);
+        }
+    }
+
+    PulseCaptureStats PulseCaptureSink::stats() const
+    {
+        PulseCaptureStats stats{};
+        stats.pulses = _pulses.load(std::memory_order_acquire);
+        if (stats.pulses)
+        {
+            stats.min_width_ns = _min_width_ns.load(std::memory_order_relaxed);
+            stats.max_width_ns = _max_width_ns.load(std::memory_order_relaxed);
+            stats.mean_width_ns = (double)_total_width_ns.load(std::memory_order_relaxed) / stats.pulses;
+        }
+
+        stats.periods = _periods.load(std::memory_order_acquire);
+        if (stats.periods)
+        {
+            stats.min_period_ns = _min_period_ns.load(std::memory_order_relaxed);
+            stats.max_period_ns = _max_period_ns.load(std::memory_order_relaxed);
+            stats.mean_period_ns = (double)_total_period_ns.load(std::memory_order_relaxed) / stats.periods;
+        }
+
+        stats.overflows = _measurements.overflows();
+        return stats;
+    }
+} // namespace GPIO
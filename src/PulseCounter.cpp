@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/PulseCounter.h"
+
+#include <algorithm>
+
+namespace GPIO
+{
+    constexpr int PulseCounter::average_shift;
+
+    void PulseCounter::add(uint64_t timestamp_ns)
+    {
+        // single writer: plain loads and stores are enough
+        uint64_t last_ns = _last_ns.load(std::memory_order_relaxed);
+        if (last_ns != 0 && timestamp_ns > last_ns)
+        {
+            uint64_t interval_ns = timestamp_ns - last_ns;
+            uint64_t average_ns = _average_interval_ns.load(std::memory_order_relaxed);
+            if (average_ns == 0)
+                average_ns = interval_ns;
+            else
+                average_ns = average_ns - (average_ns >> average_shift) + (interval_ns >> average_shift);
+
+            _interval_ns.store(interval_ns, std::memory_order_relaxed);
+            _average_interval_ns.store(average_ns, std::memory_order_relaxed);
+        }
+        _last_ns.store(timestamp_ns, std::memory_order_relaxed);
+        _count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void PulseCounter::on_edge(int, Edge, int, uint64_t timestamp_ns) { add(timestamp_ns); }
+
+    PulseCount PulseCounter::read(uint64_t now_ns) const
+    {
+        PulseCount result{};
+        result.count = _count.load(std::memory_order_acquire);
+        result.last_edge_ns = _last_ns.load(std::memory_order_relaxed);
+
+        uint64_t interval_ns = _interval_ns.load(std::memory_order_relaxed);
+        uint64_t average_ns = _average_interval_ns.load(std::memory_order_relaxed);
+        if (interval_ns == 0 || average_ns == 0)
+            return result;
+
+        // no edge for longer than the interval: the rate is at most one pulse per elapsed time
+        uint64_t elapsed_ns = now_ns > result.last_edge_ns ? now_ns - result.last_edge_ns : 0;
+        result.frequency_hz = 1e9 / std::max(interval_ns, elapsed_ns);
+        result.average_frequency_hz = 1e9 / std::max(average_ns, elapsed_ns);
+        return result;
+    }
+} // namespace GPIO
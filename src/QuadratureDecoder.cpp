@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/QuadratureDecoder.h"
+
+namespace GPIO
+{
+    namespace
+    {
+        constexpr int8_t ILLEGAL = 2;
+
+        /* step from a state to the next one (index: state << 2 | next).
+           A leading B goes 00 -> 10 -> 11 -> 01 -> 00. Each edge changes one level: an edge that leaves the state
+           as it was means an edge was missed, and a change of both levels at once can't be decoded either. */
+        constexpr int8_t transitions[16] = {
+            ILLEGAL, -1,      1,       ILLEGAL, // from 00
+            1,       ILLEGAL, ILLEGAL, -1,      // from 01
+            -1,      ILLEGAL, ILLEGAL, 1,       // from 10
+            ILLEGAL, 1,       -1,      ILLEGAL, // from 11
+        };
+    } // namespace
+
+    QuadratureDecoder::QuadratureDecoder(int gpio_a, int gpio_b) : _gpio_a(gpio_a), _gpio_b(gpio_b) {}
+
+    void QuadratureDecoder::on_start(const std::vector<int>& levels)
+    {
+        _state = (levels.at(0) ? 2u : 0u) | (levels.at(1) ? 1u : 0u);
+    }
+
+    void QuadratureDecoder::on_edge(int gpio, Edge edge, int level, uint64_t)
+    {
+        const unsigned bit = gpio == _gpio_a ? 2u : 1u;
+
+        bool high = false;
+        if (level != -1)
+            high = level != 0;
+        else if (edge != Edge::UNKNOWN)
+            high = edge == Edge::RISING;
+        else
+            high = !(_state & bit); // an edge of unknown direction toggles the level
+
+        const unsigned next = high ? (_state | bit) : (_state & ~bit);
+        const int8_t step = transitions[_state << 2 | next];
+        _state = next;
+
+        if (step == ILLEGAL)
+        {
+            // decoding goes on from the levels as they are now: the position may be off by the missed steps
+            _errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            _position.fetch_add(step, std::memory_order_relaxed);
+            _direction.store(step, std::memory_order_relaxed);
+        }
+    }
+} // namespace GPIO
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/GPIOEvent.h"
+#include "private/MainModule.h"
+#include "private/QuadratureDecoder.h"
+
+namespace GPIO
+{
+    struct QuadratureEncoder::Impl
+    {
+        int _gpio_a;
+        int _gpio_b;
+        std::shared_ptr<QuadratureDecoder> _decoder;
+
+        Impl(const ChannelInfo& ch_info_a, const ChannelInfo& ch_info_b)
+        : _gpio_a(ch_info_a.gpio), _gpio_b(ch_info_b.gpio)
+        {
+            try
+            {
+                if (_gpio_a == _gpio_b)
+                    throw std::runtime_error("The channels A and B must be different");
+
+                // channels must be setup as input
+                if (global()._app_channel_configuration(ch_info_a) != Directions::IN ||
+                    global()._app_channel_configuration(ch_info_b) != Directions::IN)
+                    throw std::runtime_error("You must setup() the GPIO channels as inputs first");
+
+                _decoder = std::make_shared<QuadratureDecoder>(_gpio_a, _gpio_b);
+
+                EventResultCode result = (EventResultCode)_add_edge_sinks(global()._backend, {ch_info_a, ch_info_b},
+                                                                          Edge::BOTH, _decoder);
+                if (result != EventResultCode::None)
+                {
+                    const char* error_msg = event_error_code_to_message[result];
+                    throw std::runtime_error(error_msg ? error_msg : "Unknown Error");
+                }
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "QuadratureEncoder::QuadratureEncoder()");
+            }
+        }
+
+        // the channels may have been cleaned up (and set up again) since: only this encoder is removed
+        ~Impl()
+        {
+            _remove_edge_sink(_gpio_a, _decoder);
+            _remove_edge_sink(_gpio_b, _decoder);
+        }
+    };
+
+    QuadratureEncoder::QuadratureEncoder(const std::string& channel_a, const std::string& channel_b)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel_a, true),
+                                   global()._channel_to_info(channel_b, true)))
+    {
+    }
+
+    QuadratureEncoder::QuadratureEncoder(int channel_a, int channel_b)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel_a, true),
+                                   global()._channel_to_info(channel_b, true)))
+    {
+    }
+
+    QuadratureEncoder::~QuadratureEncoder() = default;
+
+    // move construct & assign
+    QuadratureEncoder::QuadratureEncoder(QuadratureEncoder&& other) = default;
+    QuadratureEncoder& QuadratureEncoder::operator=(QuadratureEncoder&& other) = default;
+
+    int64_t QuadratureEncoder::position() const { return pImpl->_decoder->position(); }
+
+    int QuadratureEncoder::direction() const { return pImpl->_decoder->direction(); }
+
+    unsigned long long QuadratureEncoder::errors() const { return pImpl->_decoder->errors(); }
+} // namespace GPIO
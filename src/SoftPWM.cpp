@@ -0,0 +1,197 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/MainModule.h"
+
+namespace GPIO
+{
+    struct SoftPWM::Impl
+    {
+        ChannelInfo _ch_info;
+        SoftPWMScheduler::Handle _handle;
+        int _frequency_hz = 0;
+        double _duty_cycle_percent = 0;
+        SoftPWMStats _stats;
+
+        Impl(const ChannelInfo& ch_info, int frequency_hz) : _ch_info(ch_info)
+        {
+            try
+            {
+                _check_output();
+                _check_frequency(frequency_hz);
+                _frequency_hz = frequency_hz;
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "SoftPWM::SoftPWM()");
+            }
+        }
+
+        ~Impl()
+        {
+            try
+            {
+                stop();
+            }
+            catch (std::exception& e)
+            {
+                global()._cleanup_all();
+                std::cerr << _error_message(e, "SoftPWM::~SoftPWM()");
+                std::terminate();
+            }
+            catch (...)
+            {
+                std::cerr << "[Exception] unknown error from SoftPWM::~SoftPWM()! shut down the program." << std::endl;
+                global()._cleanup_all();
+                std::terminate();
+            }
+        }
+
+        void start(double duty_cycle_percent)
+        {
+            try
+            {
+                _check_duty_cycle(duty_cycle_percent);
+                _duty_cycle_percent = duty_cycle_percent;
+
+                auto& scheduler = global()._soft_pwm;
+                if (scheduler.running(_handle))
+                {
+                    scheduler.update(_handle, _period_ns(), _high_ns());
+                    return;
+                }
+
+                _check_output();
+                _stats = {};
+                _handle = scheduler.add(global()._backend, _ch_info, _period_ns(), _high_ns());
+                global()._output_shadow[_ch_info.id] = -1;
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "SoftPWM::start()");
+            }
+        }
+
+        void stop()
+        {
+            try
+            {
+                auto& scheduler = global()._soft_pwm;
+                _stats = scheduler.stats(_handle);
+                if (scheduler.remove(_handle))
+                    global()._output_shadow[_ch_info.id] = LOW;
+                _handle = {};
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "SoftPWM::stop()");
+            }
+        }
+
+        void ChangeFrequency(int frequency_hz)
+        {
+            try
+            {
+                _check_frequency(frequency_hz);
+                _frequency_hz = frequency_hz;
+                global()._soft_pwm.update(_handle, _period_ns(), _high_ns());
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "SoftPWM::ChangeFrequency()");
+            }
+        }
+
+        void ChangeDutyCycle(double duty_cycle_percent)
+        {
+            try
+            {
+                _check_duty_cycle(duty_cycle_percent);
+                _duty_cycle_percent = duty_cycle_percent;
+                global()._soft_pwm.update(_handle, _period_ns(), _high_ns());
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "SoftPWM::ChangeDutyCycle()");
+            }
+        }
+
+        SoftPWMStats stats() const
+        {
+            auto& scheduler = global()._soft_pwm;
+            return scheduler.running(_handle) ? scheduler.stats(_handle) : _stats;
+        }
+
+        void _check_output() const
+        {
+            if (global()._app_channel_configuration(_ch_info) != OUT)
+                throw std::runtime_error("You must setup() the GPIO channel as an OUTPUT first");
+        }
+
+        static void _check_frequency(int frequency_hz)
+        {
+            if (frequency_hz <= 0)
+                throw std::runtime_error("invalid frequency_hz");
+        }
+
+        static void _check_duty_cycle(double duty_cycle_percent)
+        {
+            if (duty_cycle_percent < 0.0 || duty_cycle_percent > 100.0)
+                throw std::runtime_error("invalid duty_cycle_percent");
+        }
+
+        int64_t _period_ns() const { return std::llround(1000000000.0 / _frequency_hz); }
+
+        int64_t _high_ns() const { return std::llround(_period_ns() * (_duty_cycle_percent / 100.0)); }
+    };
+
+    SoftPWM::SoftPWM(const std::string& channel, int frequency_hz)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true), frequency_hz))
+    {
+    }
+
+    SoftPWM::SoftPWM(int channel, int frequency_hz)
+    : pImpl(std::make_unique<Impl>(global()._channel_to_info(channel, true), frequency_hz))
+    {
+    }
+    SoftPWM::~SoftPWM() = default;
+
+    // move construct & assign
+    SoftPWM::SoftPWM(SoftPWM&& other) = default;
+    SoftPWM& SoftPWM::operator=(SoftPWM&& other) = default;
+
+    void SoftPWM::start(double duty_cycle_percent) { pImpl->start(duty_cycle_percent); }
+
+    void SoftPWM::ChangeFrequency(int frequency_hz) { pImpl->ChangeFrequency(frequency_hz); }
+
+    void SoftPWM::ChangeDutyCycle(double duty_cycle_percent) { pImpl->ChangeDutyCycle(duty_cycle_percent); }
+
+    void SoftPWM::stop() { pImpl->stop(); }
+
+    SoftPWMStats SoftPWM::stats() const { return pImpl->stats(); }
+
+} // namespace GPIO
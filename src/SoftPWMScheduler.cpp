@@ -0,0 +1,299 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/SoftPWMScheduler.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "private/MonotonicClock.h"
+
+namespace GPIO
+{
+    SoftPWMScheduler::~SoftPWMScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            _cv.notify_all();
+        }
+
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    SoftPWMScheduler::Handle SoftPWMScheduler::add(const std::shared_ptr<Backend>& backend, const ChannelInfo& ch_info,
+                                                   int64_t period_ns, int64_t high_ns)
+    {
+        if (period_ns <= 0)
+            throw std::runtime_error("invalid period_ns");
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (ch_info.line->request == nullptr)
+            throw std::runtime_error("The GPIO channel has not been set up");
+
+        for (const auto& slot : _slots)
+        {
+            if (slot.generation != 0 && slot.id == ch_info.id)
+                throw std::runtime_error("The GPIO channel is already driven by another SoftPWM");
+        }
+
+        auto free_slot = std::find_if(_slots.begin(), _slots.end(), [](const Slot& slot) { return slot.generation == 0; });
+        size_t index = free_slot - _slots.begin();
+        if (free_slot == _slots.end())
+            _slots.emplace_back();
+
+        Slot& slot = _slots[index];
+        slot = Slot{};
+        slot.generation = _next_generation++;
+        slot.backend = backend;
+        slot.line = ch_info.line;
+        slot.id = ch_info.id;
+        slot.period_ns = period_ns;
+        slot.high_ns = std::min(std::max<int64_t>(high_ns, 0), period_ns);
+        _schedule_edge(_monotonic_ns(), index, true);
+
+        if (!_thread.joinable())
+            _thread = std::thread(&SoftPWMScheduler::_run, this);
+        _notify();
+
+        return {index, slot.generation};
+    }
+
+    void SoftPWMScheduler::update(const Handle& handle, int64_t period_ns, int64_t high_ns)
+    {
+        if (period_ns <= 0)
+            throw std::runtime_error("invalid period_ns");
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        Slot* slot = _find(handle);
+        if (slot == nullptr)
+            return;
+
+        slot->period_ns = period_ns;
+        slot->high_ns = std::min(std::max<int64_t>(high_ns, 0), period_ns);
+
+        // a line held at a constant level has no edge in the schedule
+        if (!slot->pending)
+            _schedule_edge(_monotonic_ns(), handle.slot, true);
+        _notify();
+    }
+
+    bool SoftPWMScheduler::remove(const Handle& handle)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Slot* slot = _find(handle);
+        if (slot == nullptr)
+            return false;
+
+        auto backend = slot->backend;
+        auto line = slot->line;
+        _free(*slot);
+
+        // under the lock, so the timer thread can't write an edge after this
+        if (line->request != nullptr)
+            backend->write_lines(*line->request, uint64_t(1) << line->index, 0);
+        return true;
+    }
+
+    void SoftPWMScheduler::remove_channel(int id)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& slot : _slots)
+        {
+            if (slot.generation != 0 && slot.id == id)
+                _free(slot);
+        }
+    }
+
+    bool SoftPWMScheduler::running(const Handle& handle) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _find(handle) != nullptr;
+    }
+
+    SoftPWMStats SoftPWMScheduler::stats(const Handle& handle) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const Slot* slot = _find(handle);
+        if (slot == nullptr)
+            return {};
+
+        SoftPWMStats stats = slot->stats;
+        if (stats.edges > 0)
+            stats.mean_lateness_ns = double(slot->lateness_sum_ns / stats.edges);
+        return stats;
+    }
+
+    SoftPWMScheduler::Slot* SoftPWMScheduler::_find(const Handle& handle)
+    {
+        if (handle.generation == 0 || handle.slot >= _slots.size() || _slots[handle.slot].generation != handle.generation)
+            return nullptr;
+        return &_slots[handle.slot];
+    }
+
+    const SoftPWMScheduler::Slot* SoftPWMScheduler::_find(const Handle& handle) const
+    {
+        return const_cast<SoftPWMScheduler*>(this)->_find(handle);
+    }
+
+    void SoftPWMScheduler::_free(Slot& slot)
+    {
+        // the edges left in the schedule are skipped because their generation doesn't match anymore
+        slot.generation = 0;
+        slot.pending = false;
+        slot.backend = nullptr;
+        slot.line = nullptr;
+    }
+
+    void SoftPWMScheduler::_schedule_edge(int64_t deadline, size_t slot, bool high)
+    {
+        _schedule.push({deadline, slot, _slots[slot].generation, high});
+        _slots[slot].pending = true;
+    }
+
+    void SoftPWMScheduler::_notify()
+    {
+        _changed = true;
+        _cv.notify_all();
+    }
+
+    void SoftPWMScheduler::_run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_stopping)
+        {
+            if (_schedule.empty())
+            {
+                _cv.wait(lock, [this] { return _stopping || !_schedule.empty(); });
+                continue;
+            }
+
+            const Edge& next = _schedule.top();
+            if (_slots[next.slot].generation != next.generation)
+            {
+                _schedule.pop();
+                continue;
+            }
+
+            // a new channel or a new duty cycle may need an earlier edge
+            _changed = false;
+            if (_wait_until_ns(lock, _cv, next.deadline, [this] { return _changed || _stopping; }))
+                _write_due(_monotonic_ns());
+        }
+    }
+
+    void SoftPWMScheduler::_write_due(int64_t now)
+    {
+        // edges due at the same time on lines of the same request are written with one call
+        _writes.clear();
+        while (!_schedule.empty() && _schedule.top().deadline <= now)
+        {
+            Edge edge = _schedule.top();
+            _schedule.pop();
+
+            Slot& slot = _slots[edge.slot];
+            if (slot.generation != edge.generation)
+                continue;
+
+            // the current request of the line: it may have been replaced since the last edge
+            const LineRequest* request = slot.line->request.get();
+            if (request == nullptr)
+            {
+                std::cerr << "[WARNING] SoftPWM stopped on a channel that is not set up anymore" << std::endl;
+                _free(slot);
+                continue;
+            }
+
+            uint64_t bit = uint64_t(1) << slot.line->index;
+            auto write =
+                std::find_if(_writes.begin(), _writes.end(), [&](const Write& w) { return w.request == request; });
+            if (write == _writes.end())
+            {
+                _writes.push_back({slot.backend.get(), request, 0, 0});
+                write = _writes.end() - 1;
+            }
+            else if (write->mask & bit)
+            {
+                // the thread is late by more than the pulse: write the edges of the line one after the other
+                _schedule.push(edge);
+                break;
+            }
+
+            slot.pending = false;
+            bool level = false;
+            if (edge.high)
+            {
+                slot.cycle_start = edge.deadline;
+                if (slot.high_ns >= slot.period_ns)
+                {
+                    level = true;
+                }
+                else if (slot.high_ns > 0)
+                {
+                    level = true;
+                    _schedule_edge(edge.deadline + slot.high_ns, edge.slot, false);
+                }
+            }
+            else
+            {
+                int64_t next = slot.cycle_start + slot.period_ns;
+                if (next <= now)
+                {
+                    // too late for the next period: skip to the first one that hasn't started yet
+                    int64_t cycles = (now - slot.cycle_start) / slot.period_ns + 1;
+                    slot.stats.missed_cycles += cycles - 1;
+                    next = slot.cycle_start + cycles * slot.period_ns;
+                }
+                _schedule_edge(next, edge.slot, true);
+            }
+
+            int64_t lateness = now - edge.deadline;
+            slot.stats.edges++;
+            slot.stats.max_lateness_ns = std::max<long long>(slot.stats.max_lateness_ns, lateness);
+            slot.lateness_sum_ns += lateness;
+
+            write->mask |= bit;
+            write->bits = level ? (write->bits | bit) : (write->bits & ~bit);
+        }
+
+        for (const auto& write : _writes)
+        {
+            try
+            {
+                write.backend->write_lines(*write.request, write.mask, write.bits);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "[WARNING] SoftPWM stopped on a channel that can't be written: " << e.what()
+                          << std::endl;
+                for (auto& slot : _slots)
+                {
+                    if (slot.generation != 0 && slot.line->request.get() == write.request)
+                        _free(slot);
+                }
+            }
+        }
+    }
+} // namespace GPIO
@@ -0,0 +1,300 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/SysfsBackend.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "private/GPIOEvent.h"
+#include "private/PythonFunctions.h"
+#include "private/SysfsRoot.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    namespace
+    {
+        int _write_sysfs_edge(const string& gpio_name, Edge edge, bool allow_none = true)
+        {
+            auto buf = format("%s/%s/edge", _SYSFS_ROOT, gpio_name.c_str());
+
+            int edge_fd = open(buf.c_str(), O_WRONLY);
+            if (edge_fd == -1)
+            {
+                // I/O Error
+                perror("sysfs/edge open");
+                return (int)EventResultCode::SysFD_EdgeOpen;
+            }
+
+            auto get_result = [=]() -> int
+            {
+                switch (edge)
+                {
+                case Edge::RISING:
+                    return ::write(edge_fd, "rising", 6);
+                case Edge::FALLING:
+                    return ::write(edge_fd, "falling", 7);
+                case Edge::BOTH:
+                    return ::write(edge_fd, "both", 4);
+                case Edge::NONE:
+                {
+                    if (!allow_none)
+                    {
+                        return (int)EventResultCode::UnallowedEdgeNone;
+                    }
+                    return ::write(edge_fd, "none", 4);
+                }
+                case Edge::UNKNOWN:
+
+                default:
+                    cerr << format("Bad argument, edge=%i\n", (int)edge);
+                    return (int)EventResultCode::IllegalEdgeArgument;
+                }
+            };
+
+            int result = get_result();
+
+            if (result >= 0)
+                result = 0;
+            else if (result == -1)
+            {
+                // Print additional detail and label as a edge write error
+                perror("sysfs/edge write");
+                result = (int)EventResultCode::SysFD_EdgeWrite;
+            }
+
+            close(edge_fd);
+            return result;
+        }
+
+        int _open_sysfd_value(const string& gpio_name, int& fd)
+        {
+            auto buf = format("%s/%s/value", _SYSFS_ROOT, gpio_name.c_str());
+            fd = open(buf.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (fd == -1)
+            {
+                perror("sysfs/value open");
+                return (int)EventResultCode::SysFD_ValueOpen;
+            }
+
+            // Set the file descriptor to a non-blocking usage
+            int result = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            if (result == -1)
+            {
+                perror("fcntl");
+                close(fd);
+                return (int)EventResultCode::SysFD_ValueNonBlocking;
+            }
+
+            return 0;
+        }
+
+        // the value file of a channel. released by cleanup().
+        const LineRequest& _value_file(const ChannelInfo& ch_info)
+        {
+            if (ch_info.line->request == nullptr)
+                throw runtime_error("You must setup() the GPIO channel first");
+            return *ch_info.line->request;
+        }
+    } // namespace
+
+    Backends SysfsBackend::type() const { return Backends::SYSFS; }
+
+    void SysfsBackend::check_permission(const ChannelTable&) const
+    {
+        if (!os_access(_export_dir(), W_OK) || !os_access(_unexport_dir(), W_OK))
+        {
+            cerr << "[ERROR] The current user does not have permissions set to access the library functionalites. "
+                    "Please configure permissions or use the root user to run this."
+                 << endl;
+            throw runtime_error("Permission Denied.");
+        }
+    }
+
+    string SysfsBackend::_gpio_dir(const ChannelInfo& ch_info) const
+    {
+        return format("%s/%s", _SYSFS_ROOT, ch_info.gpio_name.c_str());
+    }
+
+    Directions SysfsBackend::direction(const ChannelInfo& ch_info)
+    {
+        string gpio_dir = _gpio_dir(ch_info);
+        if (!os_path_exists(gpio_dir))
+            return Directions::UNKNOWN; // Originally returns None in NVIDIA's GPIO Python Library
+
+        string gpio_direction{};
+        { // scope for f
+            ifstream f_direction(format("%s/direction", gpio_dir.c_str()));
+
+            gpio_direction = GPIO::read(f_direction);
+            gpio_direction = lower(strip(gpio_direction));
+        } // scope ends
+
+        if (gpio_direction == "in")
+            return Directions::IN;
+        else if (gpio_direction == "out")
+            return Directions::OUT;
+        else
+            return Directions::UNKNOWN; // Originally returns None in NVIDIA's GPIO Python Library
+    }
+
+    void SysfsBackend::_export_gpio(const ChannelInfo& ch_info, const char* direction)
+    {
+        string gpio_dir = _gpio_dir(ch_info);
+
+        if (!os_path_exists(gpio_dir))
+        { // scope for f_export
+            ofstream f_export(_export_dir());
+            f_export << ch_info.gpio;
+        } // scope ends
+
+        string value_path = format("%s/value", gpio_dir.c_str());
+
+        int time_count = 0;
+        while (!os_access(value_path, R_OK | W_OK))
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            if (time_count++ > 100)
+                throw runtime_error("Permission denied: path: " + value_path +
+                                    "\n Please configure permissions or use the root user to run this.");
+        }
+
+        { // scope for f_direction
+            ofstream f_direction(format("%s/direction", gpio_dir.c_str()));
+            f_direction << direction;
+        } // scope ends
+
+        auto request = make_shared<LineRequest>();
+        if (!request->fd.open(value_path, O_RDWR))
+            throw runtime_error("Can't open " + value_path + ": " + strerror(errno));
+
+        ch_info.line->request = request;
+        ch_info.line->index = 0;
+    }
+
+    void SysfsBackend::setup_out(const ChannelInfo& ch_info, int initial)
+    {
+        _export_gpio(ch_info, "out");
+
+        if (!is_None(initial))
+            write(ch_info, initial);
+    }
+
+    void SysfsBackend::setup_in(const ChannelInfo& ch_info) { _export_gpio(ch_info, "in"); }
+
+    void SysfsBackend::release(const ChannelInfo& ch_info)
+    {
+        ch_info.line->request = nullptr;
+        string gpio_dir = _gpio_dir(ch_info);
+
+        if (!os_path_exists(gpio_dir))
+            return;
+
+        ofstream f_unexport(_unexport_dir());
+        f_unexport << ch_info.gpio;
+    }
+
+    void SysfsBackend::write(const ChannelInfo& ch_info, int value)
+    {
+        // one pwrite() per call. sysfs ignores the file position, so there is nothing to seek or flush.
+        if (!_value_file(ch_info).fd.write_char(value ? '1' : '0'))
+            throw runtime_error("Failed to write the value of channel " + ch_info.channel + ": " + strerror(errno));
+    }
+
+    int SysfsBackend::read(const ChannelInfo& ch_info)
+    {
+        int c = _value_file(ch_info).fd.read_char();
+        if (c < 0)
+            throw runtime_error("Failed to read the value of channel " + ch_info.channel + ": " + strerror(errno));
+        return c == '0' ? 0 : 1;
+    }
+
+    // every line has its own value file. there is nothing to request together.
+    void SysfsBackend::group(const vector<ChannelInfo>&) {}
+
+    void SysfsBackend::write_lines(const LineRequest& request, uint64_t mask, uint64_t bits)
+    {
+        if ((mask & 1) && !request.fd.write_char((bits & 1) ? '1' : '0'))
+            throw runtime_error(string("Failed to write the value of a GPIO line: ") + strerror(errno));
+    }
+
+    uint64_t SysfsBackend::read_lines(const LineRequest& request, uint64_t mask)
+    {
+        if (!(mask & 1))
+            return 0;
+
+        int c = request.fd.read_char();
+        if (c < 0)
+            throw runtime_error(string("Failed to read the value of a GPIO line: ") + strerror(errno));
+        return c == '0' ? 0 : 1;
+    }
+
+    int SysfsBackend::open_edge(const ChannelInfo& ch_info, Edge edge, int& fd)
+    {
+        int result = _open_sysfd_value(ch_info.gpio_name, fd);
+        if (result)
+            return result;
+
+        result = _write_sysfs_edge(ch_info.gpio_name, edge);
+        if (result)
+            close(fd);
+        return result;
+    }
+
+    int SysfsBackend::set_edge(const ChannelInfo& ch_info, Edge edge)
+    {
+        return _write_sysfs_edge(ch_info.gpio_name, edge);
+    }
+
+    // sysfs has no queue of edges: report one edge with the current value, without direction or time.
+    size_t SysfsBackend::read_edges(int fd, EdgeRecord* records, size_t max)
+    {
+        if (max == 0)
+            return 0;
+
+        char value = 0;
+        int level = -1;
+        if (pread(fd, &value, 1, 0) == 1 && (value == '0' || value == '1'))
+            level = value - '0';
+
+        records[0] = {Edge::UNKNOWN, level, 0};
+        return 1;
+    }
+
+    // the sysfs interface has no debounce attribute
+    bool SysfsBackend::set_debounce(const ChannelInfo&, uint64_t) { return false; }
+
+    bool SysfsBackend::initial_edge_event() const { return true; }
+
+} // namespace GPIO
@@ -0,0 +1,234 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/WaveformPlayback.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "private/GPIOEvent.h"
+#include "private/MonotonicClock.h"
+
+namespace GPIO
+{
+    WaveformPlayback::WaveformPlayback(const std::shared_ptr<Backend>& backend,
+                                       const std::vector<ChannelInfo>& ch_infos)
+    : _ch_infos(ch_infos), _backend(backend)
+    {
+    }
+
+    WaveformPlayback::~WaveformPlayback() { stop(); }
+
+    void WaveformPlayback::start(const std::vector<WaveformStep>& steps, int64_t period_ns)
+    {
+        stop();
+        _check_steps(steps);
+
+        {
+            auto lines_lock = _lock_line_requests();
+            _steps = steps;
+            _compile();
+        }
+        _period_ns = period_ns;
+
+        _stopping = false;
+        _playing = true;
+        _failure.clear();
+        _stats = {};
+        _stats.lateness_ns.assign(_steps.size(), 0);
+        _lateness_sum_ns = 0;
+        _thread = std::thread(&WaveformPlayback::_run, this);
+    }
+
+    void WaveformPlayback::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            _cv.notify_all();
+        }
+
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    std::string WaveformPlayback::wait()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return !_playing; });
+        }
+
+        if (_thread.joinable())
+            _thread.join();
+        return _failure;
+    }
+
+    bool WaveformPlayback::playing() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _playing;
+    }
+
+    WaveformStats WaveformPlayback::stats() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        WaveformStats stats = _stats;
+        if (stats.steps > 0)
+            stats.mean_lateness_ns = double(_lateness_sum_ns / stats.steps);
+        return stats;
+    }
+
+    void WaveformPlayback::_check_steps(const std::vector<WaveformStep>& steps) const
+    {
+        if (steps.empty())
+            throw std::runtime_error("The waveform has no step");
+
+        uint64_t channels_mask = _ch_infos.size() < 64 ? (1ULL << _ch_infos.size()) - 1 : ~0ULL;
+        for (size_t i = 0; i < steps.size(); i++)
+        {
+            if (steps[i].offset_ns < 0 || (i > 0 && steps[i].offset_ns < steps[i - 1].offset_ns))
+                throw std::runtime_error("The offsets of the waveform steps must not be negative or decrease");
+            if (steps[i].mask & ~channels_mask)
+                throw std::runtime_error("A waveform step selects a channel that is not in the WaveformPlayer");
+        }
+    }
+
+    // translate the channel bits of the steps to line bits for the current line requests, so the playback only writes
+    void WaveformPlayback::_compile()
+    {
+        _segments.clear();
+        for (unsigned i = 0; i < _ch_infos.size(); i++)
+        {
+            const auto& line = _ch_infos[i].line;
+            if (line->request == nullptr)
+                throw std::runtime_error("A channel of the WaveformPlayer has been cleaned up: channel " +
+                                         _ch_infos[i].channel);
+
+            auto it = std::find_if(_segments.begin(), _segments.end(),
+                                   [&](const Segment& s) { return _same_request(s.request, line->request); });
+            if (it == _segments.end())
+                it = _segments.insert(_segments.end(), Segment{line->request, line, {}});
+            it->bits.emplace_back(i, line->index);
+        }
+
+        _step_begin.clear();
+        _writes.clear();
+        for (const auto& step : _steps)
+        {
+            _step_begin.push_back(_writes.size());
+            for (size_t s = 0; s < _segments.size(); s++)
+            {
+                uint64_t line_mask = 0;
+                uint64_t line_bits = 0;
+                for (const auto& bit : _segments[s].bits)
+                {
+                    if (!((step.mask >> bit.first) & 1))
+                        continue;
+
+                    line_mask |= 1ULL << bit.second;
+                    if ((step.values >> bit.first) & 1)
+                        line_bits |= 1ULL << bit.second;
+                }
+
+                if (line_mask != 0)
+                    _writes.push_back({s, line_mask, line_bits});
+            }
+        }
+        _step_begin.push_back(_writes.size());
+    }
+
+    // the backend may merge or split line requests (e.g. a PinGroup, add_event_detect(), cleanup() of a channel)
+    bool WaveformPlayback::_requests_changed() const
+    {
+        for (const auto& segment : _segments)
+        {
+            for (const auto& bit : segment.bits)
+            {
+                if (!_same_request(segment.request, _ch_infos[bit.first].line->request))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void WaveformPlayback::_run()
+    {
+        // the lowest real-time priority is enough to run ahead of every normal thread
+        sched_param param{};
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        bool realtime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stats.realtime = realtime;
+
+        try
+        {
+            const int64_t start = _monotonic_ns();
+            for (int64_t pass = 0; !_stopping; pass++)
+            {
+                for (size_t i = 0; i < _steps.size(); i++)
+                {
+                    int64_t deadline = start + pass * _period_ns + _steps[i].offset_ns;
+                    if (!_wait_until_ns(lock, _cv, deadline, [this] { return _stopping; }) || _stopping)
+                        break;
+
+                    long long lateness = _monotonic_ns() - deadline;
+                    {
+                        // the requests are not replaced while they are written
+                        auto lines_lock = _lock_line_requests();
+                        if (_requests_changed())
+                            _compile();
+
+                        for (size_t w = _step_begin[i]; w < _step_begin[i + 1]; w++)
+                        {
+                            const auto& write = _writes[w];
+                            _backend->write_lines(*_segments[write.segment].line->request, write.mask, write.bits);
+                        }
+                    }
+
+                    _stats.lateness_ns[i] = lateness;
+                    _stats.max_lateness_ns = std::max(_stats.max_lateness_ns, lateness);
+                    _stats.steps++;
+                    _lateness_sum_ns += lateness;
+                }
+
+                if (_stopping)
+                    break;
+
+                _stats.passes++;
+                if (_period_ns == 0)
+                    break;
+            }
+        }
+        catch (std::exception& e)
+        {
+            _failure = e.what();
+        }
+
+        _playing = false;
+        _cv.notify_all();
+    }
+} // namespace GPIO
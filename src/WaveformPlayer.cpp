@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <set>
+
+#include "JetsonGPIO.h"
+#include "private/ExceptionHandling.h"
+#include "private/MainModule.h"
+#include "private/WaveformPlayback.h"
+
+namespace GPIO
+{
+    struct WaveformPlayer::Impl
+    {
+        std::vector<ChannelInfo> _ch_infos;
+        std::unique_ptr<WaveformPlayback> _playback;
+
+        Impl(const std::vector<ChannelInfo>& ch_infos) : _ch_infos(ch_infos)
+        {
+            try
+            {
+                if (_ch_infos.empty() || _ch_infos.size() > 64)
+                    throw std::runtime_error("A WaveformPlayer must have 1 to 64 channels");
+
+                std::set<int> ids{};
+                for (const auto& ch_info : _ch_infos)
+                {
+                    if (!ids.insert(ch_info.id).second)
+                        throw std::runtime_error("Channel " + ch_info.channel + " is given more than once");
+                }
+                _check_output();
+
+                global()._group(_ch_infos);
+                _playback = std::make_unique<WaveformPlayback>(global()._backend, _ch_infos);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "WaveformPlayer::WaveformPlayer()");
+            }
+        }
+
+        void play(const std::vector<WaveformStep>& steps)
+        {
+            try
+            {
+                _start(steps, 0);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "WaveformPlayer::play()");
+            }
+        }
+
+        void loop(const std::vector<WaveformStep>& steps, int64_t period_ns)
+        {
+            try
+            {
+                if (!steps.empty() && period_ns <= steps.back().offset_ns)
+                    throw std::runtime_error("period_ns must be larger than the offset of the last step");
+                _start(steps, period_ns);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "WaveformPlayer::loop()");
+            }
+        }
+
+        void stop() { _playback->stop(); }
+
+        void wait()
+        {
+            try
+            {
+                std::string failure = _playback->wait();
+                if (!failure.empty())
+                    throw std::runtime_error(failure);
+            }
+            catch (std::exception& e)
+            {
+                throw _error(e, "WaveformPlayer::wait()");
+            }
+        }
+
+        bool playing() const { return _playback->playing(); }
+
+        WaveformStats stats() const { return _playback->stats(); }
+
+        size_t size() const { return _ch_infos.size(); }
+
+        void _check_output() const
+        {
+            for (const auto& ch_info : _ch_infos)
+            {
+                if (global()._app_channel_configuration(ch_info) != OUT)
+                    throw std::runtime_error("The GPIO channel has not been set up as an OUTPUT: channel " +
+                                             ch_info.channel);
+            }
+        }
+
+        void _start(const std::vector<WaveformStep>& steps, int64_t period_ns)
+        {
+            _playback->stop();
+            _check_output();
+            _playback->start(steps, period_ns);
+
+            // the values written by the playback are not tracked
+            for (const auto& ch_info : _ch_infos)
+                global()._output_shadow[ch_info.id] = -1;
+        }
+    };
+
+    WaveformPlayer::WaveformPlayer(const std::vector<std::string>& channels)
+    : pImpl(std::make_unique<Impl>(global()._channels_to_infos(channels, true)))
+    {
+    }
+
+    WaveformPlayer::WaveformPlayer(const std::vector<int>& channels)
+    : pImpl(std::make_unique<Impl>(global()._channels_to_infos(channels, true)))
+    {
+    }
+
+    WaveformPlayer::WaveformPlayer(const std::initializer_list<int>& channels) : WaveformPlayer(std::vector<int>(channels)) {}
+
+    WaveformPlayer::~WaveformPlayer() = default;
+
+    // move construct & assign
+    WaveformPlayer::WaveformPlayer(WaveformPlayer&& other) = default;
+    WaveformPlayer& WaveformPlayer::operator=(WaveformPlayer&& other) = default;
+
+    void WaveformPlayer::play(const std::vector<WaveformStep>& steps) { pImpl->play(steps); }
+
+    void WaveformPlayer::loop(const std::vector<WaveformStep>& steps, int64_t period_ns)
+    {
+        pImpl->loop(steps, period_ns);
+    }
+
+    void WaveformPlayer::stop() { pImpl->stop(); }
+
+    void WaveformPlayer::wait() { pImpl->wait(); }
+
+    bool WaveformPlayer::playing() const { return pImpl->playing(); }
+
+    WaveformStats WaveformPlayer::stats() const { return pImpl->stats(); }
+
+    size_t WaveformPlayer::size() const { return pImpl->size(); }
+
+} // namespace GPIO
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+/* Compares the cost of toggling/reading a GPIO value file through std::fstream
+   (the old output()/input() path) and through a raw file descriptor (the current path).
+
+   It runs against a fake sysfs tree on tmpfs, so it does not need a Jetson board:
+       bench_value_io [directory (default: /dev/shm)] [iterations (default: 200000)]
+
+   Syscall counts are read from /proc/self/io (syscr/syscw), which counts read/write family calls only.
+   The fstream path also issues an lseek() per call, which is not included in those counters;
+   run the benchmark under `strace -c` to see it. */
+
+#include "private/FileDescriptor.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    struct SyscallCount
+    {
+        long read = 0;
+        long write = 0;
+    };
+
+    SyscallCount syscall_count()
+    {
+        SyscallCount count{};
+        std::ifstream f("/proc/self/io");
+        std::string key{};
+        long value{};
+        while (f >> key >> value)
+        {
+            if (key == "syscr:")
+                count.read = value;
+            else if (key == "syscw:")
+                count.write = value;
+        }
+        return count;
+    }
+
+    template <class F> void run(const std::string& name, long iterations, F&& func)
+    {
+        auto before = syscall_count();
+        auto start = std::chrono::steady_clock::now();
+
+        for (long i = 0; i < iterations; i++)
+            func(i);
+
+        auto end = std::chrono::steady_clock::now();
+        auto after = syscall_count();
+
+        double sec = std::chrono::duration<double>(end - start).count();
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << iterations / sec << " ops/s" << std::setprecision(2) << std::setw(8)
+                  << double(after.read - before.read) / iterations << " read/op" << std::setw(8)
+                  << double(after.write - before.write) / iterations << " write/op" << std::endl;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string root = argc > 1 ? argv[1] : "/dev/shm";
+    long iterations = argc > 2 ? std::atol(argv[2]) : 200000;
+
+    // fake sysfs tree: <root>/jetson_gpio_bench/gpio12/value
+    std::string gpio_dir = root + "/jetson_gpio_bench/gpio12";
+    std::string value_path = gpio_dir + "/value";
+    mkdir((root + "/jetson_gpio_bench").c_str(), 0755);
+    mkdir(gpio_dir.c_str(), 0755);
+    {
+        std::ofstream f(value_path);
+        f << 0;
+    }
+
+    std::cout << "fake sysfs value file: " << value_path << ", iterations: " << iterations << std::endl;
+
+    { // old output() path
+        std::fstream f(value_path, std::ios::in | std::ios::out);
+        run("fstream write", iterations,
+            [&f](long i)
+            {
+                f.seekg(0, std::ios::beg);
+                f << static_cast<int>(i & 1);
+                f.flush();
+            });
+    }
+
+    { // old input() path
+        std::fstream f(value_path, std::ios::in | std::ios::out);
+        int value{};
+        run("fstream read", iterations,
+            [&f, &value](long)
+            {
+                f.seekg(0, std::ios::beg);
+                f >> value;
+                f.clear();
+            });
+    }
+
+    GPIO::FileDescriptor fd{};
+    if (!fd.open(value_path, O_RDWR))
+    {
+        std::perror("open");
+        return -1;
+    }
+
+    run("raw fd write", iterations, [&fd](long i) { fd.write_char((i & 1) ? '1' : '0'); });
+    run("raw fd read", iterations, [&fd](long) { fd.read_char(); });
+
+    fd.close();
+    unlink(value_path.c_str());
+    rmdir(gpio_dir.c_str());
+    rmdir((root + "/jetson_gpio_bench").c_str());
+    return 0;
+}
@@ -495,6 +495,223 @@ private:
         GPIO::cleanup();
     }
 
+    void test_pin_write_read()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+
+        GPIO::Pin out(pin_data.out_a);
+        GPIO::Pin in(pin_data.in_a);
+        assert::is_true(out.direction() == GPIO::OUT);
+        assert::is_true(in.direction() == GPIO::IN);
+
+        out.write(GPIO::HIGH);
+        assert::is_true(in.read() == GPIO::HIGH);
+        out.write(GPIO::LOW);
+        assert::is_true(in.read() == GPIO::LOW);
+
+        assert::expect_exception([&in]() { in.write(GPIO::HIGH); });
+
+        GPIO::cleanup();
+    }
+
+    void test_pin_group_write_read()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup({pin_data.out_a, pin_data.out_b}, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+
+        GPIO::PinGroup outs({pin_data.out_a, pin_data.out_b});
+        GPIO::PinGroup ins({pin_data.in_a, pin_data.in_b});
+        assert::is_true(outs.size() == 2);
+
+        outs.write(0b11, 0b01);
+        assert::is_true(ins.read() == 0b01);
+        outs.write(0b10, 0b10);
+        assert::is_true(ins.read() == 0b11);
+        assert::is_true(outs.read() == 0b11);
+
+        assert::expect_exception([&ins]() { ins.write(0b01, 0b01); });
+
+        GPIO::cleanup();
+    }
+
+    void test_input_many()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup({pin_data.out_a, pin_data.out_b}, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+
+        GPIO::output(pin_data.out_b, GPIO::HIGH);
+        assert::is_true(GPIO::input({pin_data.in_a, pin_data.in_b}) == 0b10);
+        assert::is_true(GPIO::input(std::vector<int>{pin_data.in_b, pin_data.in_a}) == 0b01);
+
+        GPIO::InputGroup ins({pin_data.in_a, pin_data.in_b});
+        assert::is_true(ins.read() == 0b10);
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        assert::is_true(ins.read() == 0b11);
+
+        GPIO::cleanup();
+        assert::expect_exception([&ins]() { ins.read(); });
+    }
+
+    void test_toggle_and_output_cache()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+
+        GPIO::toggle(pin_data.out_a);
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::HIGH);
+        GPIO::toggle(pin_data.out_a);
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::LOW);
+        assert::expect_exception([this]() { GPIO::toggle(pin_data.in_a); });
+
+        GPIO::setoutputcache(true);
+        GPIO::output(pin_data.out_a, GPIO::LOW);
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::HIGH);
+        GPIO::setoutputcache(false);
+
+        auto stats = GPIO::output_stats(pin_data.out_a);
+        assert::is_true(stats.writes == 5);
+        assert::is_true(stats.elided == 2);
+
+        GPIO::cleanup();
+    }
+
+    void test_soft_pwm_multi_duty()
+    {
+        for (auto pct : {0.0, 25.0, 50.0, 75.0, 100.0})
+        {
+            GPIO::setmode(GPIO::BOARD);
+            GPIO::setup(pin_data.in_a, GPIO::IN);
+            GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::HIGH);
+
+            int count = 0;
+
+            GPIO::SoftPWM p(pin_data.out_a, 500);
+            p.start(pct);
+            constexpr int N = 5000;
+            for (int i = 0; i < N; i++)
+                count += GPIO::input(pin_data.in_a);
+
+            assert::is_true(p.stats().edges > 0);
+            p.stop();
+            assert::is_true(GPIO::input(pin_data.in_a) == GPIO::LOW);
+
+            const auto delta = 10;
+            const auto min_ct = N * (pct - delta) / 100.0;
+            const auto max_ct = N * (pct + delta) / 100.0;
+
+            assert::is_true(min_ct <= count && count <= max_ct);
+            GPIO::cleanup();
+        }
+    }
+
+    void test_soft_pwm_cleanup()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        assert::expect_exception([this]() { GPIO::SoftPWM p(pin_data.out_b, 100); });
+
+        GPIO::SoftPWM p(pin_data.out_a, 100);
+        p.start(50.0);
+        p.ChangeFrequency(200);
+        p.ChangeDutyCycle(25.0);
+
+        // the channel is not driven anymore after cleanup, stop() does nothing
+        GPIO::cleanup();
+        p.stop();
+        assert::expect_exception([&p]() { p.start(50.0); });
+    }
+
+    void test_waveform_play()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup({pin_data.out_a, pin_data.out_b}, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+
+        GPIO::WaveformPlayer player({pin_data.out_a, pin_data.out_b});
+        assert::is_true(player.size() == 2);
+
+        // 1 ms apart: a, a+b, b
+        std::vector<GPIO::WaveformStep> steps{{0, 0b01, 0b01}, {1000000, 0b10, 0b10}, {2000000, 0b01, 0b00}};
+        player.play(steps);
+        player.wait();
+        assert::is_false(player.playing());
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::LOW);
+        assert::is_true(GPIO::input(pin_data.in_b) == GPIO::HIGH);
+
+        auto stats = player.stats();
+        assert::is_true(stats.steps == 3);
+        assert::is_true(stats.passes == 1);
+        assert::is_true(stats.lateness_ns.size() == 3);
+
+        // invalid waveforms
+        assert::expect_exception([&player]() { player.play({}); });
+        assert::expect_exception([&player]() { player.play({{1000, 0b01, 0b01}, {0, 0b01, 0b00}}); });
+        assert::expect_exception([&player]() { player.play({{0, 0b100, 0b100}}); });
+        assert::expect_exception([&player, &steps]() { player.loop(steps, 2000000); });
+
+        GPIO::cleanup();
+    }
+
+    void test_waveform_loop()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        assert::expect_exception([this]() { GPIO::WaveformPlayer player({pin_data.out_a, pin_data.out_b}); });
+
+        GPIO::WaveformPlayer player({pin_data.out_a});
+        player.loop({{0, 1, 1}, {500000, 1, 0}}, 1000000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert::is_true(player.playing());
+        player.stop();
+        assert::is_false(player.playing());
+        assert::is_true(player.stats().passes > 1);
+
+        // cleanup() stops the playback with an error
+        player.loop({{0, 1, 1}, {500000, 1, 0}}, 1000000);
+        GPIO::cleanup();
+        assert::expect_exception([&player]() { player.wait(); });
+    }
+
+    void test_pin_toggle()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+
+        GPIO::Pin out(pin_data.out_a);
+        out.toggle();
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::HIGH);
+        out.toggle();
+        assert::is_true(GPIO::input(pin_data.in_a) == GPIO::LOW);
+
+        GPIO::cleanup();
+    }
+
+    void test_pin_not_setup()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        assert::expect_exception([this]() { GPIO::Pin pin(pin_data.out_a); });
+        GPIO::cleanup();
+    }
+
+    void test_setbackend_after_setmode()
+    {
+        GPIO::Backends backend = GPIO::getbackend();
+        GPIO::setbackend(backend);
+
+        GPIO::setmode(GPIO::BOARD);
+        assert::expect_exception([]() { GPIO::setbackend(GPIO::CDEV); });
+        assert::is_true(GPIO::getbackend() == backend);
+        GPIO::cleanup();
+    }
+
     void test_gpio_function_unexported()
     {
         GPIO::setmode(GPIO::BOARD);
@@ -547,6 +764,175 @@ private:
         GPIO::cleanup();
     }
 
+    void test_pulse_counter()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+        GPIO::add_pulse_counter(pin_data.in_a, GPIO::RISING);
+        for (int i = 0; i < 10; i++)
+        {
+            GPIO::output(pin_data.out_a, GPIO::HIGH);
+            sleep(0.005);
+            GPIO::output(pin_data.out_a, GPIO::LOW);
+            sleep(0.005);
+        }
+
+        // about 100 Hz, lower as time passes after the last edge
+        auto pulses = GPIO::pulse_count(pin_data.in_a);
+        assert::is_true(pulses.count == 10);
+        assert::is_true(pulses.average_frequency_hz > 30 && pulses.average_frequency_hz < 150);
+        GPIO::remove_event_detect(pin_data.in_a);
+        GPIO::cleanup();
+    }
+
+    void test_pulse_capture()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+        {
+            GPIO::PulseCapture capture(pin_data.in_a);
+            for (int i = 0; i < 5; i++)
+            {
+                GPIO::output(pin_data.out_a, GPIO::HIGH);
+                sleep(0.002);
+                GPIO::output(pin_data.out_a, GPIO::LOW);
+                sleep(0.008);
+            }
+            sleep(0.01);
+
+            GPIO::PulseMeasurement measurements[8]{};
+            assert::is_true(capture.read(measurements, 8) == 5);
+            auto stats = capture.stats();
+            assert::is_true(stats.pulses == 5 && stats.periods == 4);
+            assert::is_true(stats.mean_width_ns > 1.5e6 && stats.mean_width_ns < 4e6);
+            assert::is_true(stats.mean_period_ns > 9e6 && stats.mean_period_ns < 15e6);
+        }
+        GPIO::cleanup();
+    }
+
+    void test_quadrature_encoder()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup({pin_data.out_a, pin_data.out_b}, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+        {
+            GPIO::QuadratureEncoder encoder(pin_data.in_a, pin_data.in_b);
+
+            // 2 cycles with A leading B, then one with B leading A
+            const int forward[][2] = {{1, 0}, {1, 1}, {0, 1}, {0, 0}};
+            for (int step = 0; step < 8; step++)
+            {
+                GPIO::output(pin_data.out_a, forward[step % 4][0]);
+                GPIO::output(pin_data.out_b, forward[step % 4][1]);
+                sleep(0.005);
+            }
+            assert::is_true(encoder.position() == 8);
+            assert::is_true(encoder.direction() == 1);
+
+            for (int step = 2; step >= -1; step--)
+            {
+                GPIO::output(pin_data.out_a, forward[(step + 4) % 4][0]);
+                GPIO::output(pin_data.out_b, forward[(step + 4) % 4][1]);
+                sleep(0.005);
+            }
+            assert::is_true(encoder.position() == 4);
+            assert::is_true(encoder.direction() == -1);
+            assert::is_true(encoder.errors() == 0);
+        }
+        GPIO::cleanup();
+    }
+
+    void test_glitch_filter()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup(pin_data.in_a, GPIO::IN);
+        GPIO::add_event_detect(pin_data.in_a, GPIO::BOTH);
+        GPIO::set_event_buffer(pin_data.in_a, 8);
+        GPIO::set_glitch_filter(pin_data.in_a, 2000);
+
+        // a pulse much shorter than the window, then a level that holds
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        GPIO::output(pin_data.out_a, GPIO::LOW);
+        sleep(0.01);
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        sleep(0.01);
+
+        GPIO::EdgeEvent events[8]{};
+        assert::is_true(GPIO::read_events(pin_data.in_a, events, 8) == 1);
+        assert::is_true(events[0].edge == GPIO::RISING && events[0].level == GPIO::HIGH);
+
+        std::string channel = std::to_string(pin_data.in_a);
+        for (const auto& stats : GPIO::event_stats().channels)
+        {
+            if (stats.channel == channel)
+                assert::is_true(stats.glitches >= 1);
+        }
+
+        GPIO::remove_event_detect(pin_data.in_a);
+        GPIO::cleanup();
+    }
+
+    void test_reflex()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup({pin_data.out_a, pin_data.out_b}, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+        GPIO::add_event_detect(pin_data.in_a, GPIO::BOTH);
+        GPIO::add_reflex(pin_data.in_a, GPIO::RISING, pin_data.out_b, GPIO::HIGH);
+        GPIO::add_reflex(pin_data.in_a, GPIO::FALLING, pin_data.out_b, GPIO::TOGGLE);
+
+        // out_b follows in_a without any call on this thread
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        sleep(0.01);
+        assert::is_true(GPIO::input(pin_data.in_b) == GPIO::HIGH);
+        GPIO::output(pin_data.out_a, GPIO::LOW);
+        sleep(0.01);
+        assert::is_true(GPIO::input(pin_data.in_b) == GPIO::LOW);
+
+        std::string channel = std::to_string(pin_data.in_a);
+        for (const auto& stats : GPIO::event_stats().channels)
+        {
+            if (stats.channel == channel)
+                assert::is_true(stats.reflexes == 2 && stats.max_reflex_ns > 0);
+        }
+
+        // removed with the edge detection
+        GPIO::remove_event_detect(pin_data.in_a);
+        GPIO::output(pin_data.out_a, GPIO::HIGH);
+        sleep(0.01);
+        assert::is_true(GPIO::input(pin_data.in_b) == GPIO::LOW);
+
+        // the output cache skips the writes of out_b again, also after a reflex that could not be added
+        assert::expect_exception([&]() { GPIO::add_reflex(pin_data.in_a, GPIO::RISING, pin_data.out_b, GPIO::HIGH); });
+        GPIO::setoutputcache(true);
+        GPIO::output(pin_data.out_b, GPIO::LOW);
+        GPIO::output(pin_data.out_b, GPIO::LOW);
+        assert::is_true(GPIO::output_stats(pin_data.out_b).elided >= 1);
+        GPIO::setoutputcache(false);
+        GPIO::cleanup();
+    }
+
+    void test_wait_for_edges()
+    {
+        GPIO::setmode(GPIO::BOARD);
+        GPIO::setup(pin_data.out_a, GPIO::OUT, GPIO::LOW);
+        GPIO::setup({pin_data.in_a, pin_data.in_b}, GPIO::IN);
+        auto dsc = DelayedSetChannel(pin_data.out_a, GPIO::HIGH, 0.5);
+        auto events = GPIO::wait_for_edges({pin_data.in_b, pin_data.in_a}, GPIO::RISING, 10, 1000);
+        dsc.wait();
+        assert::is_true(events.size() == 1);
+        assert::is_true(std::stoi(events[0].channel) == pin_data.in_a);
+        assert::is_true(events[0].edge == GPIO::RISING);
+
+        // timeout
+        events = GPIO::wait_for_edges({pin_data.in_b, pin_data.in_a}, GPIO::RISING, 0, 100);
+        assert::is_true(events.empty());
+        GPIO::cleanup();
+    }
+
     // clang-format off
 
     void test_event_detected_rising()
@@ -801,6 +1187,17 @@ private:
         ADD_TEST(test_multiple_outputs1);
         ADD_TEST(test_out_in_init_high);
         ADD_TEST(test_out_in_init_low);
+        ADD_TEST(test_pin_write_read);
+        ADD_TEST(test_pin_toggle);
+        ADD_TEST(test_pin_group_write_read);
+        ADD_TEST(test_input_many);
+        ADD_TEST(test_toggle_and_output_cache);
+        ADD_TEST(test_soft_pwm_multi_duty);
+        ADD_TEST(test_soft_pwm_cleanup);
+        ADD_TEST(test_waveform_play);
+        ADD_TEST(test_waveform_loop);
+        ADD_TEST(test_pin_not_setup);
+        ADD_TEST(test_setbackend_after_setmode);
         ADD_TEST(test_gpio_function_unexported);
         ADD_TEST(test_gpio_function_in);
         ADD_TEST(test_gpio_function_out);
@@ -808,6 +1205,12 @@ private:
         // event
         ADD_TEST(test_wait_for_edge_rising);
         ADD_TEST(test_wait_for_edge_falling);
+        ADD_TEST(test_wait_for_edges);
+        ADD_TEST(test_pulse_counter);
+        ADD_TEST(test_pulse_capture);
+        ADD_TEST(test_quadrature_encoder);
+        ADD_TEST(test_glitch_filter);
+        ADD_TEST(test_reflex);
         ADD_TEST(test_event_detected_rising);
         ADD_TEST(test_event_detected_falling);
         ADD_TEST(test_event_detected_both);
@@ -0,0 +1,182 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+#include "JetsonGPIO/Callback.h"
+#include "private/TestUtility.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// counts the allocations of the test, to check that storing and calling a small callback doesn't allocate
+static std::atomic<size_t> allocations{0};
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    std::string last_channel;
+    uint64_t last_seqno = 0;
+    int no_arg_calls = 0;
+
+    void event_callback(const GPIO::EdgeEvent& event) { last_seqno = event.seqno; }
+    void string_callback(const std::string& channel) { last_channel = channel; }
+    void no_arg_callback() { no_arg_calls++; }
+
+    GPIO::EdgeEvent make_event(const std::string& channel, uint64_t seqno)
+    {
+        GPIO::EdgeEvent event{};
+        event.channel = channel;
+        event.seqno = seqno;
+        return event;
+    }
+
+    // equality comparable callable object
+    struct Counter
+    {
+        int* count;
+        void operator()(const GPIO::EdgeEvent&) const { (*count)++; }
+        bool operator==(const Counter& other) const { return count == other.count; }
+    };
+
+    // too large for the inline buffer
+    struct LargeCounter
+    {
+        std::array<int*, 8> counts;
+        void operator()() const { (*counts[0])++; }
+        bool operator==(const LargeCounter& other) const { return counts == other.counts; }
+    };
+
+    void Arguments()
+    {
+        auto event = make_event("12", 3);
+
+        GPIO::Callback{event_callback}(event);
+        assert::are_equal((uint64_t)3, last_seqno);
+
+        GPIO::Callback{string_callback}(event);
+        assert::are_equal(std::string("12"), last_channel);
+
+        no_arg_calls = 0;
+        GPIO::Callback{no_arg_callback}(event);
+        GPIO::Callback{no_arg_callback}(std::string("12"));
+        assert::are_equal(2, no_arg_calls);
+
+        // an empty callback does nothing
+        GPIO::Callback empty = nullptr;
+        empty(event);
+        assert::is_true(empty == nullptr);
+    }
+
+    void Equality()
+    {
+        int a = 0, b = 0;
+        assert::is_true(GPIO::Callback(event_callback) == GPIO::Callback(event_callback));
+        assert::is_true(GPIO::Callback(event_callback) != GPIO::Callback(string_callback));
+        assert::is_true(GPIO::Callback(Counter{&a}) == GPIO::Callback(Counter{&a}));
+        assert::is_true(GPIO::Callback(Counter{&a}) != GPIO::Callback(Counter{&b}));
+        assert::is_true(GPIO::Callback(Counter{&a}) != nullptr);
+
+        void (*null_function)() = nullptr;
+        assert::is_true(GPIO::Callback(null_function) == nullptr);
+    }
+
+    void ContextCallback()
+    {
+        int a = 0, b = 0;
+        auto increment = [](const GPIO::EdgeEvent&, void* context) { (*static_cast<int*>(context))++; };
+
+        GPIO::Callback callback(increment, &a);
+        callback(make_event("1", 1));
+        assert::are_equal(1, a);
+        assert::is_true(callback == GPIO::Callback(increment, &a));
+        assert::is_true(callback != GPIO::Callback(increment, &b));
+    }
+
+    void CopyAndMove()
+    {
+        int count = 0;
+        GPIO::Callback small(Counter{&count});
+        GPIO::Callback large(LargeCounter{{&count}});
+
+        GPIO::Callback small_copy = small;
+        GPIO::Callback large_copy = large;
+        small_copy(make_event("1", 1));
+        large_copy(make_event("1", 1));
+        assert::are_equal(2, count);
+        assert::is_true(small_copy == small && large_copy == large);
+
+        GPIO::Callback moved = std::move(large_copy);
+        moved(make_event("1", 1));
+        assert::are_equal(3, count);
+        assert::is_true(moved == large);
+
+        moved = small;
+        assert::is_true(moved == small);
+        moved = nullptr;
+        assert::is_true(moved == nullptr);
+    }
+
+    void NoAllocation()
+    {
+        int count = 0;
+        auto event = make_event("12", 1);
+
+        size_t before = allocations;
+        GPIO::Callback function(event_callback);
+        GPIO::Callback object(Counter{&count});
+        GPIO::Callback copy = object;
+        function(event);
+        object(event);
+        copy(event);
+        GPIO::Callback moved = std::move(copy);
+        assert::are_equal((size_t)0, allocations - before);
+        assert::are_equal(2, count);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(Arguments));
+    suit.add(TEST(Equality));
+    suit.add(TEST(ContextCallback));
+    suit.add(TEST(CopyAndMove));
+    suit.add(TEST(NoAllocation));
+#undef TEST
+
+    return suit.run();
+}
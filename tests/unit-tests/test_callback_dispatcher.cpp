@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include "private/CallbackDispatcher.h"
+#include "private/TestUtility.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // the channel names of the test events are "<key>:<sequence number>"
+    std::mutex record_mutex;
+    std::map<int, std::vector<int>> records;
+    std::atomic_int running[4];
+    std::atomic_bool overlap{false};
+    std::atomic_bool hold{false};
+
+    void record(const GPIO::EdgeEvent& event)
+    {
+        int key = std::stoi(event.channel);
+        int seq = (int)event.seqno;
+
+        if (running[key]++ != 0)
+            overlap = true;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        while (hold)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        {
+            std::lock_guard<std::mutex> lock(record_mutex);
+            records[key].push_back(seq);
+        }
+        running[key]--;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(record_mutex);
+        records.clear();
+        for (auto& r : running)
+            r = 0;
+        overlap = false;
+        hold = false;
+    }
+
+    bool post(GPIO::CallbackDispatcher& dispatcher, int key, int seq)
+    {
+        static const auto callbacks = std::make_shared<const GPIO::CallbackList>(1, GPIO::Callback(record));
+        GPIO::EdgeEvent event{};
+        event.channel = std::to_string(key);
+        event.seqno = seq;
+        return dispatcher.post(key, callbacks, event);
+    }
+
+    bool wait_dispatched(const GPIO::CallbackDispatcher& dispatcher, unsigned long long count)
+    {
+        for (int i = 0; i < 2000; i++)
+        {
+            if (dispatcher.stats().dispatched >= count)
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    void PerKeyOrder()
+    {
+        reset();
+        GPIO::CallbackDispatcher dispatcher;
+        dispatcher.set_workers(4);
+
+        constexpr int N = 50;
+        for (int seq = 0; seq < N; seq++)
+        {
+            for (int key = 0; key < 4; key++)
+                assert::is_true(post(dispatcher, key, seq));
+        }
+        assert::is_true(wait_dispatched(dispatcher, 4 * N));
+
+        // never two callbacks of one key at a time, in the posted order
+        assert::is_false(overlap.load());
+        std::lock_guard<std::mutex> lock(record_mutex);
+        for (int key = 0; key < 4; key++)
+        {
+            assert::are_equal((size_t)N, records[key].size());
+            for (int seq = 0; seq < N; seq++)
+                assert::are_equal(seq, records[key][seq]);
+        }
+    }
+
+    void FullQueueDrops()
+    {
+        reset();
+        GPIO::CallbackDispatcher dispatcher;
+        dispatcher.set_capacity(2);
+
+        // the worker is stuck in the first event
+        hold = true;
+        assert::is_true(post(dispatcher, 0, 0));
+        while (running[0] == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        assert::is_true(post(dispatcher, 0, 1));
+        assert::is_true(post(dispatcher, 1, 0));
+        assert::is_false(post(dispatcher, 1, 1));
+
+        auto stats = dispatcher.stats();
+        assert::are_equal((size_t)2, stats.queued);
+        assert::are_equal((size_t)2, stats.max_queued);
+        assert::are_equal(1ULL, stats.dropped);
+
+        hold = false;
+        assert::is_true(wait_dispatched(dispatcher, 3));
+        assert::are_equal((size_t)0, dispatcher.stats().queued);
+    }
+
+    void Discard()
+    {
+        reset();
+        GPIO::CallbackDispatcher dispatcher;
+
+        hold = true;
+        post(dispatcher, 0, 0);
+        while (running[0] == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        post(dispatcher, 0, 1);
+        post(dispatcher, 1, 0);
+
+        dispatcher.discard(0);
+        assert::are_equal((size_t)1, dispatcher.stats().queued);
+
+        hold = false;
+        assert::is_true(wait_dispatched(dispatcher, 2));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::lock_guard<std::mutex> lock(record_mutex);
+        assert::are_equal((size_t)1, records[0].size());
+        assert::are_equal((size_t)1, records[1].size());
+    }
+
+    GPIO::CallbackDispatcher* current_dispatcher = nullptr;
+    std::atomic_bool waited_in_callback{false};
+    void wait_own_key(const GPIO::EdgeEvent& event)
+    {
+        current_dispatcher->wait_idle(std::stoi(event.channel));
+        waited_in_callback = true;
+    }
+
+    void WaitIdle()
+    {
+        reset();
+        GPIO::CallbackDispatcher dispatcher;
+
+        // returns when the callback being run has returned
+        hold = true;
+        post(dispatcher, 0, 0);
+        while (running[0] == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::thread release(
+            []()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                hold = false;
+            });
+        dispatcher.wait_idle(0);
+        assert::are_equal(0, running[0].load());
+        release.join();
+
+        // at once for a key without callbacks being run
+        dispatcher.wait_idle(1);
+
+        // and when called from the callback
+        current_dispatcher = &dispatcher;
+        waited_in_callback = false;
+        GPIO::EdgeEvent event{};
+        event.channel = "2";
+        dispatcher.post(2, std::make_shared<const GPIO::CallbackList>(1, GPIO::Callback(wait_own_key)), event);
+        assert::is_true(wait_dispatched(dispatcher, 2));
+        assert::is_true(waited_in_callback.load());
+    }
+
+    void InvalidSettings()
+    {
+        GPIO::CallbackDispatcher dispatcher;
+        assert::expect_exception([&]() { dispatcher.set_workers(0); });
+        assert::expect_exception([&]() { dispatcher.set_capacity(0); });
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(PerKeyOrder));
+    suit.add(TEST(FullQueueDrops));
+    suit.add(TEST(Discard));
+    suit.add(TEST(WaitIdle));
+    suit.add(TEST(InvalidSettings));
+#undef TEST
+
+    return suit.run();
+}
@@ -0,0 +1,473 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include "private/CdevBackend.h"
+#include "private/GPIOEvent.h"
+#include "private/TestUtility.h"
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // A GPIO chip simulated in memory. File descriptors are eventfds so that they can be closed and duplicated.
+    class MockCdevIO : public GPIO::CdevIO
+    {
+    public:
+        struct Line
+        {
+            uint64_t flags = 0;
+            int value = 0;
+            uint32_t debounce_us = 0;
+            bool requested = false;
+        };
+
+        std::map<unsigned, Line> lines{};                // line offset -> line
+        std::map<int, std::vector<unsigned>> requests{}; // line request fd -> line offsets
+        std::deque<gpio_v2_line_event> events{};
+        gpio_v2_line_request last_request{};
+        gpio_v2_line_values last_values{};
+        int busy_count = 0; // number of GPIO_V2_GET_LINE_IOCTL calls failing with EBUSY
+        int set_values_count = 0;
+
+        int open(const char*, int) override { return eventfd(0, EFD_CLOEXEC); }
+
+        // lines of closed requests are free again
+        void collect_closed_requests()
+        {
+            for (auto it = requests.begin(); it != requests.end();)
+            {
+                if (fcntl(it->first, F_GETFD) != -1)
+                {
+                    it++;
+                    continue;
+                }
+
+                for (auto offset : it->second)
+                    lines[offset].requested = false;
+                it = requests.erase(it);
+            }
+        }
+
+        void apply_config(const std::vector<unsigned>& offsets, const gpio_v2_line_config& config)
+        {
+            for (size_t i = 0; i < offsets.size(); i++)
+            {
+                Line& line = lines[offsets[i]];
+                line.flags = config.flags;
+                line.debounce_us = 0;
+                for (unsigned a = 0; a < config.num_attrs; a++)
+                {
+                    const auto& attr = config.attrs[a];
+                    if (!((attr.mask >> i) & 1))
+                        continue;
+                    if (attr.attr.id == GPIO_V2_LINE_ATTR_ID_FLAGS)
+                        line.flags = attr.attr.flags;
+                    else if (attr.attr.id == GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES)
+                        line.value = (attr.attr.values >> i) & 1;
+                    else if (attr.attr.id == GPIO_V2_LINE_ATTR_ID_DEBOUNCE)
+                        line.debounce_us = attr.attr.debounce_period_us;
+                }
+            }
+        }
+
+        int ioctl(int fd, unsigned long request, void* arg) override
+        {
+            switch (request)
+            {
+            case GPIO_V2_GET_LINEINFO_IOCTL:
+            {
+                collect_closed_requests();
+                auto info = static_cast<gpio_v2_line_info*>(arg);
+                const Line& line = lines[info->offset];
+                info->flags = line.requested ? (line.flags | GPIO_V2_LINE_FLAG_USED) : 0;
+                return 0;
+            }
+            case GPIO_V2_GET_LINE_IOCTL:
+            {
+                collect_closed_requests();
+                auto req = static_cast<gpio_v2_line_request*>(arg);
+                std::vector<unsigned> offsets(req->offsets, req->offsets + req->num_lines);
+                bool busy = busy_count > 0;
+                for (auto offset : offsets)
+                    busy = busy || lines[offset].requested;
+                if (busy)
+                {
+                    busy_count = busy_count > 0 ? busy_count - 1 : 0;
+                    errno = EBUSY;
+                    return -1;
+                }
+
+                for (auto offset : offsets)
+                    lines[offset].requested = true;
+                apply_config(offsets, req->config);
+
+                req->fd = eventfd(0, EFD_CLOEXEC);
+                requests[req->fd] = offsets;
+                last_request = *req;
+                return 0;
+            }
+            case GPIO_V2_LINE_SET_CONFIG_IOCTL:
+            {
+                apply_config(requests.at(fd), *static_cast<gpio_v2_line_config*>(arg));
+                return 0;
+            }
+            case GPIO_V2_LINE_SET_VALUES_IOCTL:
+            {
+                auto values = static_cast<gpio_v2_line_values*>(arg);
+                const auto& offsets = requests.at(fd);
+                for (size_t i = 0; i < offsets.size(); i++)
+                {
+                    if ((values->mask >> i) & 1)
+                        lines[offsets[i]].value = (values->bits >> i) & 1;
+                }
+                last_values = *values;
+                set_values_count++;
+                return 0;
+            }
+            case GPIO_V2_LINE_GET_VALUES_IOCTL:
+            {
+                auto values = static_cast<gpio_v2_line_values*>(arg);
+                const auto& offsets = requests.at(fd);
+                values->bits = 0;
+                for (size_t i = 0; i < offsets.size(); i++)
+                {
+                    if (lines[offsets[i]].value)
+                        values->bits |= 1ULL << i;
+                }
+                values->bits &= values->mask;
+                return 0;
+            }
+            default:
+                errno = ENOTTY;
+                return -1;
+            }
+        }
+
+        ssize_t read(int, void* buf, size_t count) override
+        {
+            if (events.empty())
+            {
+                errno = EAGAIN;
+                return -1;
+            }
+
+            size_t n = 0;
+            auto out = static_cast<gpio_v2_line_event*>(buf);
+            while (!events.empty() && (n + 1) * sizeof(gpio_v2_line_event) <= count)
+            {
+                out[n++] = events.front();
+                events.pop_front();
+            }
+            return n * sizeof(gpio_v2_line_event);
+        }
+    };
+
+    GPIO::ChannelInfo make_channel(const std::string& cdev = "/dev/gpiochip0", int offset = 12)
+    {
+        return GPIO::ChannelInfo{0, std::to_string(offset), "/sys/devices/gpio", cdev, offset, 300 + offset,
+                                 "gpio" + std::to_string(300 + offset), "None", -1};
+    }
+
+    void SetupOutput()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+
+        backend.setup_out(ch_info, 1);
+
+        assert::is_true(ch_info.line->request != nullptr);
+        assert::are_equal(1u, io->last_request.num_lines);
+        assert::are_equal(12u, io->last_request.offsets[0]);
+        assert::are_equal(std::string("JetsonGPIO"), std::string(io->last_request.consumer));
+        assert::are_equal((uint64_t)GPIO_V2_LINE_FLAG_OUTPUT, (uint64_t)io->last_request.config.flags);
+        assert::are_equal(1, io->lines[12].value);
+        assert::is_true(GPIO::Directions::OUT == backend.direction(ch_info));
+    }
+
+    void WriteRead()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+
+        backend.setup_out(ch_info, 0);
+        assert::are_equal(0, backend.read(ch_info));
+
+        backend.write(ch_info, 1);
+        assert::are_equal((uint64_t)1, (uint64_t)io->last_values.mask);
+        assert::are_equal((uint64_t)1, (uint64_t)io->last_values.bits);
+        assert::are_equal(1, backend.read(ch_info));
+
+        backend.write(ch_info, 0);
+        assert::are_equal((uint64_t)0, (uint64_t)io->last_values.bits);
+        assert::are_equal(0, backend.read(ch_info));
+    }
+
+    void SetupInputAndRelease()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+        assert::is_true(GPIO::Directions::UNKNOWN == backend.direction(ch_info));
+
+        backend.setup_in(ch_info);
+        assert::is_true(GPIO::Directions::IN == backend.direction(ch_info));
+
+        int fd = ch_info.line->request->fd.get();
+        backend.release(ch_info);
+        assert::is_true(ch_info.line->request == nullptr);
+        assert::are_equal(-1, fcntl(fd, F_GETFD), "the line request fd must be closed");
+    }
+
+    void WriteAfterRelease()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+        backend.setup_out(ch_info, 0);
+        backend.release(ch_info);
+
+        // a Pin kept after cleanup() still reaches the backend: it must throw, not dereference the released request
+        assert::expect_exception([&]() { backend.write(ch_info, 1); });
+        assert::expect_exception([&]() { backend.read(ch_info); });
+        assert::are_equal(0, io->set_values_count);
+    }
+
+    void BusyLineThrows()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+
+        // requested by another process: not retried
+        io->busy_count = 1;
+        assert::expect_exception([&]() { backend.setup_in(ch_info); });
+        assert::is_true(ch_info.line->request == nullptr);
+    }
+
+    void MissingCharacterDevice()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel("None");
+
+        assert::expect_exception([&]() { backend.setup_in(ch_info); });
+    }
+
+    void EdgeDetection()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        auto ch_info = make_channel();
+        backend.setup_in(ch_info);
+
+        int fd = -1;
+        assert::are_equal(0, backend.open_edge(ch_info, GPIO::Edge::BOTH, fd));
+        assert::is_true(fd >= 0 && fd != ch_info.line->request->fd.get());
+        assert::is_true(fcntl(fd, F_GETFL) & O_NONBLOCK);
+        assert::are_equal(
+            (uint64_t)(GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING),
+            (uint64_t)io->lines[12].flags);
+
+        assert::are_equal(0, backend.set_edge(ch_info, GPIO::Edge::FALLING));
+        assert::are_equal((uint64_t)(GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING),
+                          (uint64_t)io->lines[12].flags);
+
+        assert::are_equal((int)GPIO::EventResultCode::IllegalEdgeArgument,
+                          backend.set_edge(ch_info, GPIO::Edge::UNKNOWN));
+        assert::is_false(backend.initial_edge_event());
+        close(fd);
+    }
+
+    void Debounce()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        std::vector<GPIO::ChannelInfo> group = {make_channel("/dev/gpiochip0", 1), make_channel("/dev/gpiochip0", 2)};
+        backend.setup_in(group[0]);
+        backend.setup_out(group[1], 1);
+
+        int fd = -1;
+        assert::are_equal(0, backend.open_edge(group[0], GPIO::Edge::BOTH, fd));
+        assert::is_true(backend.set_debounce(group[0], 5000));
+        assert::are_equal((uint32_t)5000, io->lines[1].debounce_us);
+        assert::are_equal(
+            (uint64_t)(GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING),
+            (uint64_t)io->lines[1].flags);
+
+        // kept when the edge changes
+        assert::are_equal(0, backend.set_edge(group[0], GPIO::Edge::RISING));
+        assert::are_equal((uint32_t)5000, io->lines[1].debounce_us);
+
+        assert::is_true(backend.set_debounce(group[0], 0));
+        assert::are_equal((uint32_t)0, io->lines[1].debounce_us);
+
+        // out of range of the attribute, or released: debounced by the caller
+        assert::is_false(backend.set_debounce(group[0], 1ULL << 32));
+        backend.release(group[0]);
+        assert::is_false(backend.set_debounce(group[0], 5000));
+        assert::are_equal(1, io->lines[2].value);
+        close(fd);
+    }
+
+    void GroupMergesRequests()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        std::vector<GPIO::ChannelInfo> group = {make_channel("/dev/gpiochip0", 1), make_channel("/dev/gpiochip0", 2),
+                                                make_channel("/dev/gpiochip0", 3), make_channel("/dev/gpiochip1", 4)};
+        backend.setup_out(group[0], 1);
+        backend.setup_out(group[1], 0);
+        backend.setup_in(group[2]);
+        backend.setup_out(group[3], 0);
+
+        backend.group(group);
+
+        // one request for the three lines of gpiochip0. values and directions are kept.
+        auto request = group[0].line->request;
+        assert::is_true(request == group[1].line->request && request == group[2].line->request);
+        assert::is_true(request != group[3].line->request);
+        assert::are_equal(1, io->lines[1].value);
+        assert::are_equal(0, io->lines[2].value);
+        assert::are_equal((uint64_t)GPIO_V2_LINE_FLAG_INPUT, (uint64_t)io->lines[3].flags);
+        assert::are_equal((uint64_t)GPIO_V2_LINE_FLAG_OUTPUT, (uint64_t)io->lines[2].flags);
+
+        // one system call for the chip
+        uint64_t mask = (1ULL << group[0].line->index) | (1ULL << group[1].line->index);
+        int count = io->set_values_count;
+        backend.write_lines(*request, mask, 1ULL << group[1].line->index);
+        assert::are_equal(count + 1, io->set_values_count);
+        assert::are_equal(0, io->lines[1].value);
+        assert::are_equal(1, io->lines[2].value);
+        assert::are_equal(1ULL << group[1].line->index, backend.read_lines(*request, mask));
+
+        // single line access still works on the merged request
+        backend.write(group[0], 1);
+        assert::are_equal(1, backend.read(group[0]));
+        assert::are_equal(1, backend.read(group[1]));
+    }
+
+    void ReleaseMergedLine()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        std::vector<GPIO::ChannelInfo> group = {make_channel("/dev/gpiochip0", 1), make_channel("/dev/gpiochip0", 2)};
+        backend.setup_out(group[0], 0);
+        backend.setup_out(group[1], 1);
+        backend.group(group);
+
+        backend.release(group[0]);
+        assert::is_true(group[0].line->request == nullptr);
+        assert::is_true(group[1].line->request != nullptr);
+        assert::are_equal(1, backend.read(group[1]));
+        assert::is_true(GPIO::Directions::UNKNOWN == backend.direction(group[0]));
+
+        // the released line can be requested again
+        backend.setup_in(group[0]);
+        assert::is_true(GPIO::Directions::IN == backend.direction(group[0]));
+    }
+
+    void EdgeDetectionSplitsMergedRequest()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+        std::vector<GPIO::ChannelInfo> group = {make_channel("/dev/gpiochip0", 1), make_channel("/dev/gpiochip0", 2)};
+        backend.setup_in(group[0]);
+        backend.setup_out(group[1], 1);
+        backend.group(group);
+        assert::is_true(group[0].line->request == group[1].line->request);
+
+        int fd = -1;
+        assert::are_equal(0, backend.open_edge(group[0], GPIO::Edge::RISING, fd));
+        assert::is_true(group[0].line->request != group[1].line->request);
+        assert::are_equal((uint64_t)(GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING),
+                          (uint64_t)io->lines[1].flags);
+        assert::are_equal(1, io->lines[2].value);
+
+        // a line detecting edges is not merged again
+        backend.group(group);
+        assert::is_true(group[0].line->request != group[1].line->request);
+        close(fd);
+    }
+
+    void ReadEdges()
+    {
+        auto io = std::make_shared<MockCdevIO>();
+        GPIO::CdevBackend backend(io);
+
+        io->events.resize(40);
+        for (size_t i = 0; i < io->events.size(); i++)
+        {
+            io->events[i].timestamp_ns = 1000 + i;
+            io->events[i].id = i % 2 ? GPIO_V2_LINE_EVENT_FALLING_EDGE : GPIO_V2_LINE_EVENT_RISING_EDGE;
+        }
+
+        GPIO::EdgeRecord records[32]{};
+        assert::are_equal((size_t)32, backend.read_edges(-1, records, 32));
+        assert::is_true(GPIO::Edge::RISING == records[0].edge);
+        assert::are_equal(1, records[0].level);
+        assert::are_equal((uint64_t)1000, records[0].timestamp_ns);
+        assert::is_true(GPIO::Edge::FALLING == records[31].edge);
+        assert::are_equal(0, records[31].level);
+        assert::are_equal((uint64_t)1031, records[31].timestamp_ns);
+
+        assert::are_equal((size_t)8, backend.read_edges(-1, records, 32));
+        assert::are_equal((uint64_t)1039, records[7].timestamp_ns);
+        assert::is_true(io->events.empty());
+        assert::are_equal((size_t)0, backend.read_edges(-1, records, 32));
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(SetupOutput));
+    suit.add(TEST(WriteRead));
+    suit.add(TEST(SetupInputAndRelease));
+    suit.add(TEST(WriteAfterRelease));
+    suit.add(TEST(BusyLineThrows));
+    suit.add(TEST(MissingCharacterDevice));
+    suit.add(TEST(EdgeDetection));
+    suit.add(TEST(Debounce));
+    suit.add(TEST(GroupMergesRequests));
+    suit.add(TEST(ReleaseMergedLine));
+    suit.add(TEST(EdgeDetectionSplitsMergedRequest));
+    suit.add(TEST(ReadEdges));
+#undef TEST
+
+    return suit.run();
+}
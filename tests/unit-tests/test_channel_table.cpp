@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/ChannelTable.h"
+#include "private/TestUtility.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    GPIO::ChannelTable make_table(const std::vector<std::string>& names)
+    {
+        std::vector<GPIO::ChannelInfo> channels{};
+        for (const auto& name : names)
+        {
+            int id = static_cast<int>(channels.size());
+            channels.push_back({id, name, "/sys/devices/gpio", "/dev/gpiochip0", id, 100 + id,
+                                "gpio" + std::to_string(100 + id), "None", -1});
+        }
+        return GPIO::ChannelTable(channels);
+    }
+
+    const std::vector<std::string> board_pins = {"7",  "11", "12", "13", "15", "16", "18", "19", "21", "22", "23",
+                                                 "24", "26", "29", "31", "32", "33", "35", "36", "37", "38", "40"};
+
+    void FindNumber()
+    {
+        auto table = make_table(board_pins);
+        for (size_t i = 0; i < board_pins.size(); i++)
+        {
+            auto ch_info = table.find(std::stoi(board_pins[i]));
+            assert::is_true(ch_info != nullptr, board_pins[i]);
+            assert::are_equal(board_pins[i], ch_info->channel);
+            assert::are_equal(static_cast<int>(i), ch_info->id);
+        }
+    }
+
+    void FindNumberAsString()
+    {
+        auto table = make_table(board_pins);
+        for (const auto& pin : board_pins)
+        {
+            auto ch_info = table.find(pin);
+            assert::is_true(ch_info != nullptr, pin);
+            assert::are_equal(pin, ch_info->channel);
+        }
+    }
+
+    void InvalidNumber()
+    {
+        auto table = make_table(board_pins);
+        assert::is_true(table.find(0) == nullptr);
+        assert::is_true(table.find(1) == nullptr);
+        assert::is_true(table.find(-7) == nullptr);
+        assert::is_true(table.find(41) == nullptr);
+        assert::is_true(table.find(100000) == nullptr);
+        assert::is_true(table.find("07") == nullptr);
+        assert::is_true(table.find("") == nullptr);
+    }
+
+    void FindName()
+    {
+        std::vector<std::string> names = {"GPIO01", "GPIO11", "GPIO12", "SPI0_MOSI", "SPI0_MISO", "SPI0_SCK",
+                                          "UART1_RTS", "I2S0_SCLK", "GPIO07", "GP167", "MCLK05", "AUD_MCLK"};
+        auto table = make_table(names);
+        for (const auto& name : names)
+        {
+            auto ch_info = table.find(name);
+            assert::is_true(ch_info != nullptr, name);
+            assert::are_equal(name, ch_info->channel);
+        }
+
+        assert::is_true(table.find("GPIO1") == nullptr);
+        assert::is_true(table.find("gpio01") == nullptr);
+        assert::is_true(table.find(1) == nullptr);
+    }
+
+    void ManyNames()
+    {
+        std::vector<std::string> names{};
+        for (int i = 0; i < 500; i++)
+            names.push_back("PIN_" + std::to_string(i * 7919));
+
+        auto table = make_table(names);
+        for (const auto& name : names)
+        {
+            auto ch_info = table.find(name);
+            assert::is_true(ch_info != nullptr, name);
+            assert::are_equal(name, ch_info->channel);
+        }
+    }
+
+    void DuplicatedName()
+    {
+        auto table = make_table({"7", "None", "11", "None"});
+        assert::are_equal(1, table.find("None")->id);
+        assert::are_equal(0, table.find(7)->id);
+        assert::are_equal(2, table.find(11)->id);
+        assert::are_equal(4u, table.size());
+    }
+
+    void Empty()
+    {
+        GPIO::ChannelTable table{};
+        assert::is_true(table.find(7) == nullptr);
+        assert::is_true(table.find("7") == nullptr);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(FindNumber));
+    suit.add(TEST(FindNumberAsString));
+    suit.add(TEST(InvalidNumber));
+    suit.add(TEST(FindName));
+    suit.add(TEST(ManyNames));
+    suit.add(TEST(DuplicatedName));
+    suit.add(TEST(Empty));
+#undef TEST
+
+    return suit.run();
+}
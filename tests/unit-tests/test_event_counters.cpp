@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/EventCounters.h"
+#include "private/TestUtility.h"
+
+namespace
+{
+    void Counts()
+    {
+        GPIO::EventCounters counters("7");
+        for (int i = 0; i < 5; i++)
+            counters.add_edge();
+        counters.add_debounced();
+
+        auto stats = counters.read();
+        assert::are_equal(std::string("7"), stats.channel);
+        assert::are_equal(5ULL, stats.edges);
+        assert::are_equal(1ULL, stats.debounced);
+        assert::are_equal(0ULL, stats.callbacks);
+        assert::are_equal((uint64_t)0, stats.p99_callback_ns);
+    }
+
+    void CallbackDurations()
+    {
+        GPIO::EventCounters counters("7");
+
+        // 98 calls of 1000 ns, one of 100 us and one of 5 ms
+        for (int i = 0; i < 98; i++)
+            counters.add_callback(1000);
+        counters.add_callback(100000);
+        counters.add_callback(5000000);
+
+        auto stats = counters.read();
+        assert::are_equal(100ULL, stats.callbacks);
+        assert::are_equal((uint64_t)5000000, stats.max_callback_ns);
+
+        // upper bounds of the powers of 2 buckets
+        assert::are_equal((uint64_t)1023, stats.p50_callback_ns);
+        assert::are_equal((uint64_t)131071, stats.p99_callback_ns);
+
+        // never above the maximum
+        GPIO::EventCounters one("8");
+        one.add_callback(1500);
+        assert::are_equal((uint64_t)1500, one.read().p99_callback_ns);
+    }
+
+    void ReflexLatencies()
+    {
+        GPIO::EventCounters counters("7");
+        counters.add_callback(100000);
+        counters.add_reflex(3000);
+        counters.add_reflex(5000);
+        counters.add_reflex_error();
+
+        // apart from the callback durations
+        auto stats = counters.read();
+        assert::are_equal(2ULL, stats.reflexes);
+        assert::are_equal(1ULL, stats.reflex_errors);
+        assert::are_equal((uint64_t)5000, stats.max_reflex_ns);
+        assert::are_equal((uint64_t)4095, stats.p50_reflex_ns);
+        assert::are_equal((uint64_t)100000, stats.max_callback_ns);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(Counts));
+    suit.add(TEST(CallbackDurations));
+    suit.add(TEST(ReflexLatencies));
+#undef TEST
+
+    return suit.run();
+}
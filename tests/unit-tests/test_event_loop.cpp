@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/GPIOEvent.h"
+#include "private/TestUtility.h"
+
+#include <dirent.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Edge detection on eventfds: writing to the eventfd of a channel is an edge.
+    class EventfdBackend : public GPIO::Backend
+    {
+    public:
+        std::map<int, int> edge_fds{}; // gpio -> eventfd written by trigger()
+
+        ~EventfdBackend() override
+        {
+            for (const auto& fd : edge_fds)
+                close(fd.second);
+        }
+
+        void trigger(int gpio)
+        {
+            uint64_t one = 1;
+            assert::is_true(::write(edge_fds.at(gpio), &one, sizeof(one)) == sizeof(one));
+        }
+
+        GPIO::Backends type() const override { return GPIO::Backends::CDEV; }
+        void check_permission(const GPIO::ChannelTable&) const override {}
+        GPIO::Directions direction(const GPIO::ChannelInfo&) override { return GPIO::Directions::IN; }
+        void setup_out(const GPIO::ChannelInfo&, int) override {}
+        void setup_in(const GPIO::ChannelInfo&) override {}
+        void release(const GPIO::ChannelInfo&) override {}
+        void write(const GPIO::ChannelInfo&, int) override {}
+        int read(const GPIO::ChannelInfo&) override { return 0; }
+        void group(const std::vector<GPIO::ChannelInfo>&) override {}
+        void write_lines(const GPIO::LineRequest&, uint64_t, uint64_t) override {}
+        uint64_t read_lines(const GPIO::LineRequest&, uint64_t) override { return 0; }
+        int set_edge(const GPIO::ChannelInfo&, GPIO::Edge) override { return 0; }
+        bool set_debounce(const GPIO::ChannelInfo&, uint64_t) override { return false; }
+        bool initial_edge_event() const override { return false; }
+
+        int open_edge(const GPIO::ChannelInfo& ch_info, GPIO::Edge, int& fd) override
+        {
+            if (edge_fds.count(ch_info.gpio) == 0)
+                edge_fds[ch_info.gpio] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            fd = dup(edge_fds[ch_info.gpio]);
+            return 0;
+        }
+
+        size_t read_edges(int fd, GPIO::EdgeRecord* records, size_t max) override
+        {
+            uint64_t count = 0;
+            if (max == 0 || ::read(fd, &count, sizeof(count)) <= 0)
+                return 0;
+
+            records[0] = {GPIO::Edge::UNKNOWN, 1, 0};
+            return 1;
+        }
+    };
+
+    GPIO::ChannelInfo make_channel(int gpio)
+    {
+        return GPIO::ChannelInfo{0, std::to_string(gpio), "/sys/devices/gpio", "/dev/gpiochip0", gpio, gpio,
+                                 "gpio" + std::to_string(gpio), "None", -1};
+    }
+
+    bool readable(int fd, int timeout_ms)
+    {
+        pollfd poll_fd{fd, POLLIN, 0};
+        return poll(&poll_fd, 1, timeout_ms) == 1;
+    }
+
+    size_t thread_count()
+    {
+        size_t count = 0;
+        DIR* dir = opendir("/proc/self/task");
+        while (dirent* entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+                count++;
+        }
+        closedir(dir);
+        return count;
+    }
+
+    std::vector<std::thread::id> callback_threads;
+    void record_thread() { callback_threads.push_back(std::this_thread::get_id()); }
+
+    void EmbeddedLoop()
+    {
+        assert::are_equal((int)GPIO::EventResultCode::EventLoopNotEmbedded, GPIO::_process_events());
+
+        const int fd = GPIO::_event_fd();
+        assert::is_true(fd >= 0);
+        assert::are_equal(fd, GPIO::_event_fd());
+
+        // the change is applied by _process_events()
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(1), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(1, GPIO::Callback(record_thread)));
+        assert::is_true(readable(fd, 1000));
+        assert::are_equal(0, GPIO::_process_events());
+        assert::is_false(readable(fd, 0));
+
+        // the callbacks are called on this thread
+        backend->trigger(1);
+        backend->trigger(1); // one edge for the eventfd backend
+        assert::is_true(readable(fd, 1000));
+        assert::are_equal(1, GPIO::_process_events());
+        assert::is_true(callback_threads == std::vector<std::thread::id>{std::this_thread::get_id()});
+        assert::is_true(GPIO::_edge_event_detected(1));
+        assert::is_false(readable(fd, 0));
+        assert::are_equal((size_t)1, thread_count());
+
+        GPIO::_remove_edge_detect(1);
+        assert::is_true(readable(fd, 1000));
+        assert::are_equal(0, GPIO::_process_events());
+        assert::is_false(readable(fd, 0));
+
+        // the edges of a removed channel are not handled
+        backend->trigger(1);
+        assert::is_false(readable(fd, 10));
+        assert::are_equal((size_t)1, thread_count());
+    }
+
+    void NoEventThread()
+    {
+        // the mode is kept: the next detection doesn't start the event thread either
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(2), GPIO::Edge::RISING, 0));
+        assert::are_equal((size_t)1, thread_count());
+        GPIO::_remove_edge_detect(2);
+        assert::are_equal(0, GPIO::_process_events());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(EmbeddedLoop));
+    suit.add(TEST(NoEventThread));
+#undef TEST
+
+    return suit.run();
+}
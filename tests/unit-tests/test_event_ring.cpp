@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+#include "private/EventRing.h"
+#include "private/TestUtility.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    GPIO::EdgeEvent make_event(uint64_t seqno)
+    {
+        GPIO::EdgeEvent event{};
+        event.channel = "7";
+        event.seqno = seqno;
+        return event;
+    }
+
+    void FifoOrder()
+    {
+        GPIO::EventRing ring(4);
+        GPIO::EdgeEvent events[4]{};
+
+        // wraps around the end of the slots several times
+        uint64_t next = 1, expected = 1;
+        for (int round = 0; round < 10; round++)
+        {
+            for (int i = 0; i < 3; i++)
+                assert::is_true(ring.push(make_event(next++)));
+            assert::are_equal((size_t)3, ring.size());
+
+            assert::are_equal((size_t)2, ring.pop(events, 2));
+            assert::are_equal((size_t)1, ring.pop(events + 2, 4));
+            for (int i = 0; i < 3; i++)
+                assert::are_equal(expected++, events[i].seqno);
+        }
+        assert::are_equal(std::string("7"), events[0].channel);
+        assert::are_equal((size_t)0, ring.pop(events, 4));
+    }
+
+    void Overflow()
+    {
+        GPIO::EventRing ring(2);
+        assert::is_true(ring.push(make_event(1)));
+        assert::is_true(ring.push(make_event(2)));
+        assert::is_false(ring.push(make_event(3)));
+        assert::is_false(ring.push(make_event(4)));
+        assert::are_equal(2ULL, ring.overflows());
+
+        // the oldest events are kept
+        GPIO::EdgeEvent events[2]{};
+        assert::are_equal((size_t)2, ring.pop(events, 2));
+        assert::are_equal((uint64_t)1, events[0].seqno);
+        assert::are_equal((uint64_t)2, events[1].seqno);
+
+        assert::is_true(ring.push(make_event(5)));
+        assert::are_equal(2ULL, ring.overflows());
+        assert::are_equal(2, (int)ring.capacity());
+
+        assert::expect_exception([]() { GPIO::EventRing empty(0); });
+    }
+
+    void ConcurrentReader()
+    {
+        constexpr uint64_t N = 100000;
+        GPIO::EventRing ring(64);
+        std::atomic_bool done{false};
+
+        std::thread producer(
+            [&]()
+            {
+                for (uint64_t seqno = 1; seqno <= N; seqno++)
+                    ring.push(make_event(seqno));
+                done = true;
+            });
+
+        // every event is either read once, in order, or counted as an overflow
+        std::vector<GPIO::EdgeEvent> events(16);
+        uint64_t received = 0, last = 0;
+        bool in_order = true;
+        while (true)
+        {
+            bool finished = done;
+            size_t count = ring.pop(events.data(), events.size());
+            for (size_t i = 0; i < count; i++)
+            {
+                in_order &= events[i].seqno > last;
+                last = events[i].seqno;
+            }
+            received += count;
+            if (finished && count == 0)
+                break;
+        }
+        producer.join();
+
+        assert::is_true(in_order);
+        assert::are_equal(N, received + ring.overflows());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(FifoOrder));
+    suit.add(TEST(Overflow));
+    suit.add(TEST(ConcurrentReader));
+#undef TEST
+
+    return suit.run();
+}
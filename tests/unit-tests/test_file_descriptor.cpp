@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+#include "private/TestUtility.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    // a fake sysfs value file
+    class TemporaryFile
+    {
+    public:
+        TemporaryFile()
+        {
+            char name[] = "/tmp/jetson_gpio_test_XXXXXX";
+            int fd = mkstemp(name);
+            assert::is_true(fd >= 0, "mkstemp failed");
+            ::close(fd);
+            path = name;
+        }
+
+        ~TemporaryFile() { unlink(path.c_str()); }
+
+        std::string path;
+    };
+
+    void OpenClose()
+    {
+        TemporaryFile file{};
+        GPIO::FileDescriptor fd{};
+        assert::is_false(fd.is_open());
+
+        assert::is_true(fd.open(file.path, O_RDWR));
+        assert::is_true(fd.is_open());
+
+        fd.close();
+        assert::is_false(fd.is_open());
+        assert::are_equal(-1, fd.get());
+    }
+
+    void OpenFail()
+    {
+        GPIO::FileDescriptor fd{};
+        assert::is_false(fd.open("/this/path/does/not/exist", O_RDWR));
+        assert::is_false(fd.is_open());
+    }
+
+    void WriteRead()
+    {
+        TemporaryFile file{};
+        GPIO::FileDescriptor fd{};
+        assert::is_true(fd.open(file.path, O_RDWR));
+
+        assert::is_true(fd.write_char('1'));
+        assert::are_equal('1', fd.read_char());
+
+        // always at offset 0: the file never grows
+        assert::is_true(fd.write_char('0'));
+        assert::is_true(fd.write_char('0'));
+        assert::are_equal('0', fd.read_char());
+        assert::are_equal(1, lseek(fd.get(), 0, SEEK_END));
+    }
+
+    void ReadClosed()
+    {
+        GPIO::FileDescriptor fd{};
+        assert::are_equal(-1, fd.read_char());
+        assert::is_false(fd.write_char('1'));
+    }
+
+    void Move()
+    {
+        TemporaryFile file{};
+        GPIO::FileDescriptor a{};
+        assert::is_true(a.open(file.path, O_RDWR));
+        int raw = a.get();
+
+        GPIO::FileDescriptor b = std::move(a);
+        assert::is_false(a.is_open());
+        assert::are_equal(raw, b.get());
+
+        GPIO::FileDescriptor c{};
+        c = std::move(b);
+        assert::is_false(b.is_open());
+        assert::are_equal(raw, c.get());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(OpenClose));
+    suit.add(TEST(OpenFail));
+    suit.add(TEST(WriteRead));
+    suit.add(TEST(ReadClosed));
+    suit.add(TEST(Move));
+#undef TEST
+
+    return suit.run();
+}
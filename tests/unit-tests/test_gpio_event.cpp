@@ -0,0 +1,1045 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include "private/EdgeSink.h"
+#include "private/GPIOEvent.h"
+#include "private/MonotonicClock.h"
+#include "private/TestUtility.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /* Edge detection on eventfds: writing to the eventfd of a channel is an edge.
+       open_edge() returns a duplicate, like the character device backend. */
+    class EventfdBackend : public GPIO::Backend
+    {
+    public:
+        std::map<int, int> edge_fds{}; // gpio -> eventfd written by trigger()
+        std::atomic<uint64_t> timestamp_ns{0}; // of the edges read, 0 if the backend doesn't record it
+        bool initial_event = false;            // like sysfs: an edge is reported when the detection starts
+        std::atomic<int> edge_level{1};        // level of the edges read
+        std::atomic<int> value{0};             // returned by read()
+        bool can_debounce = false;             // set_debounce() succeeds, like the character device backend
+        std::map<int, uint64_t> debounce_us{}; // gpio -> debounce period set
+        std::atomic<int> written{-1};          // last value written
+        std::atomic<int> write_count{0};
+        int last_edge_fd = -1;                 // last fd returned by open_edge()
+
+        ~EventfdBackend() override
+        {
+            for (const auto& fd : edge_fds)
+                close(fd.second);
+        }
+
+        void trigger(int gpio)
+        {
+            uint64_t one = 1;
+            assert::is_true(::write(edge_fds.at(gpio), &one, sizeof(one)) == sizeof(one));
+        }
+
+        GPIO::Backends type() const override { return GPIO::Backends::CDEV; }
+        void check_permission(const GPIO::ChannelTable&) const override {}
+        GPIO::Directions direction(const GPIO::ChannelInfo&) override { return GPIO::Directions::IN; }
+        void setup_out(const GPIO::ChannelInfo&, int) override {}
+        void setup_in(const GPIO::ChannelInfo&) override {}
+        void release(const GPIO::ChannelInfo&) override {}
+        void write(const GPIO::ChannelInfo&, int value) override
+        {
+            written = value;
+            write_count++;
+        }
+        int read(const GPIO::ChannelInfo&) override { return value; }
+        void group(const std::vector<GPIO::ChannelInfo>&) override {}
+        void write_lines(const GPIO::LineRequest&, uint64_t, uint64_t) override {}
+        uint64_t read_lines(const GPIO::LineRequest&, uint64_t) override { return 0; }
+        int set_edge(const GPIO::ChannelInfo&, GPIO::Edge) override { return 0; }
+        bool set_debounce(const GPIO::ChannelInfo& ch_info, uint64_t period_us) override
+        {
+            if (can_debounce)
+                debounce_us[ch_info.gpio] = period_us;
+            return can_debounce;
+        }
+        bool initial_edge_event() const override { return initial_event; }
+
+        int open_edge(const GPIO::ChannelInfo& ch_info, GPIO::Edge, int& fd) override
+        {
+            if (edge_fds.count(ch_info.gpio) == 0)
+                edge_fds[ch_info.gpio] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            fd = dup(edge_fds[ch_info.gpio]);
+            last_edge_fd = fd;
+            return 0;
+        }
+
+        // The writes since the last read are one rising edge
+        size_t read_edges(int fd, GPIO::EdgeRecord* records, size_t max) override
+        {
+            uint64_t count = 0;
+            if (max == 0 || ::read(fd, &count, sizeof(count)) <= 0)
+                return 0;
+
+            records[0] = {GPIO::Edge::UNKNOWN, edge_level, timestamp_ns};
+            return 1;
+        }
+    };
+
+    /* Like sysfs: every read of a value fd is an edge with the current level, whether the line has changed or not,
+       and the detection starts with an edge */
+    class SysfsLikeBackend : public EventfdBackend
+    {
+    public:
+        SysfsLikeBackend() { initial_event = true; }
+
+        GPIO::Backends type() const override { return GPIO::Backends::SYSFS; }
+
+        int open_edge(const GPIO::ChannelInfo& ch_info, GPIO::Edge edge, int& fd) override
+        {
+            int result = EventfdBackend::open_edge(ch_info, edge, fd);
+            trigger(ch_info.gpio);
+            return result;
+        }
+
+        size_t read_edges(int fd, GPIO::EdgeRecord* records, size_t max) override
+        {
+            if (max == 0)
+                return 0;
+
+            uint64_t count = 0;
+            if (::read(fd, &count, sizeof(count)) == -1 && errno != EAGAIN)
+                return 0;
+
+            records[0] = {GPIO::Edge::UNKNOWN, value, 0};
+            return 1;
+        }
+    };
+
+    GPIO::ChannelInfo make_channel(int gpio)
+    {
+        return GPIO::ChannelInfo{0, std::to_string(gpio), "/sys/devices/gpio", "/dev/gpiochip0", gpio, gpio,
+                                 "gpio" + std::to_string(gpio), "None", -1};
+    }
+
+    std::atomic_int callback_count{0};
+    void count_callback() { callback_count++; }
+
+    std::mutex event_mutex;
+    std::vector<GPIO::EdgeEvent> received_events;
+    void record_event(const GPIO::EdgeEvent& event)
+    {
+        std::lock_guard<std::mutex> lock(event_mutex);
+        received_events.push_back(event);
+    }
+
+    size_t received_count()
+    {
+        std::lock_guard<std::mutex> lock(event_mutex);
+        return received_events.size();
+    }
+
+    bool wait_for(const std::function<bool()>& condition, int timeout_ms = 1000)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // voluntary context switches of all the threads of the process
+    long context_switches()
+    {
+        long total = 0;
+        DIR* dir = opendir("/proc/self/task");
+        while (dirent* entry = readdir(dir))
+        {
+            if (entry->d_name[0] == '.')
+                continue;
+
+            std::ifstream status(std::string("/proc/self/task/") + entry->d_name + "/status");
+            std::string line;
+            while (std::getline(status, line))
+            {
+                if (line.rfind("voluntary_ctxt_switches:", 0) == 0)
+                    total += std::stol(line.substr(line.find(':') + 1));
+            }
+        }
+        closedir(dir);
+        return total;
+    }
+
+    void CallbackIsCalled()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        auto ch_info = make_channel(7);
+        callback_count = 0;
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, ch_info, GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(7, GPIO::Callback(count_callback)));
+        assert::is_true(GPIO::_edge_event_exists(7));
+
+        // the thread blocks in epoll_wait: the event must still be added and reported
+        backend->trigger(7);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+        assert::is_true(GPIO::_edge_event_detected(7));
+        assert::is_false(GPIO::_edge_event_detected(7));
+
+        backend->trigger(7);
+        assert::is_true(wait_for([]() { return callback_count == 2; }));
+
+        GPIO::_remove_edge_detect(7);
+        assert::is_false(GPIO::_edge_event_exists(7));
+    }
+
+    void EdgeEventRecord()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        received_events.clear();
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(8), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(8, GPIO::Callback(record_event)));
+
+        // without a timestamp from the backend, the edge is stamped when the thread wakes up
+        uint64_t before = GPIO::_monotonic_ns();
+        backend->trigger(8);
+        assert::is_true(wait_for([]() { return received_count() == 1; }));
+        uint64_t after = GPIO::_monotonic_ns();
+
+        backend->timestamp_ns = 123456789;
+        backend->trigger(8);
+        assert::is_true(wait_for([]() { return received_count() == 2; }));
+
+        std::lock_guard<std::mutex> lock(event_mutex);
+        const auto& first = received_events[0];
+        assert::are_equal(std::string("8"), first.channel);
+        assert::is_true(GPIO::Edge::RISING == first.edge);
+        assert::are_equal(1, first.level);
+        assert::is_true(before <= first.timestamp_ns && first.timestamp_ns <= after);
+        assert::are_equal((uint64_t)1, first.seqno);
+
+        const auto& second = received_events[1];
+        assert::are_equal((uint64_t)123456789, second.timestamp_ns);
+        assert::are_equal((uint64_t)2, second.seqno);
+
+        GPIO::_remove_edge_detect(8);
+    }
+
+    void BounceTimeUsesTimestamps()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        received_events.clear();
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(9), GPIO::Edge::RISING, 5));
+        assert::are_equal(0, GPIO::_add_edge_callback(9, GPIO::Callback(record_event)));
+
+        // 1 ms after the first edge: filtered out, 6 ms after: reported
+        for (uint64_t ms : {10, 11, 16})
+        {
+            backend->timestamp_ns = ms * 1000000;
+            backend->trigger(9);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        assert::is_true(wait_for([]() { return received_count() == 2; }));
+
+        std::lock_guard<std::mutex> lock(event_mutex);
+        assert::are_equal((uint64_t)10000000, received_events[0].timestamp_ns);
+        assert::are_equal((uint64_t)16000000, received_events[1].timestamp_ns);
+        assert::are_equal((uint64_t)2, received_events[1].seqno);
+
+        // counted in the event stats
+        auto channel_stats = []()
+        {
+            for (const auto& channel : GPIO::_event_stats().channels)
+            {
+                if (channel.channel == "9")
+                    return channel;
+            }
+            return GPIO::ChannelEventStats{};
+        };
+        assert::is_true(wait_for([&]() { return channel_stats().callbacks == 2; }));
+        auto stats = channel_stats();
+        assert::are_equal(3ULL, stats.edges);
+        assert::are_equal(1ULL, stats.debounced);
+        assert::is_false(stats.kernel_debounce);
+        assert::is_true(stats.p50_callback_ns <= stats.p99_callback_ns);
+        assert::is_true(stats.p99_callback_ns <= stats.max_callback_ns);
+        assert::is_true(GPIO::_event_stats().wakeups >= 3);
+
+        GPIO::_remove_edge_detect(9);
+    }
+
+    void KernelDebounce()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        backend->can_debounce = true;
+        received_events.clear();
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(23), GPIO::Edge::RISING, 5));
+        assert::are_equal(0, GPIO::_add_edge_callback(23, GPIO::Callback(record_event)));
+        assert::are_equal((uint64_t)5000, backend->debounce_us.at(23));
+
+        // the edges reaching the event thread are already debounced: none is dropped again
+        for (uint64_t ms : {10, 11})
+        {
+            backend->timestamp_ns = ms * 1000000;
+            backend->trigger(23);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        assert::is_true(wait_for([]() { return received_count() == 2; }));
+
+        auto channel_stats = []()
+        {
+            for (const auto& channel : GPIO::_event_stats().channels)
+            {
+                if (channel.channel == "23")
+                    return channel;
+            }
+            return GPIO::ChannelEventStats{};
+        };
+        auto stats = channel_stats();
+        assert::is_true(stats.kernel_debounce);
+        assert::are_equal(0ULL, stats.debounced);
+
+        // turned off with the detection
+        GPIO::_remove_edge_detect(23);
+        assert::is_true(wait_for([&]() { return channel_stats().channel.empty(); }));
+        assert::are_equal((uint64_t)0, backend->debounce_us.at(23));
+    }
+
+    // the value written by the reflex when the callback is called
+    std::shared_ptr<EventfdBackend> reflex_backend;
+    std::atomic<int> written_at_callback{-1};
+    std::atomic<int> reflex_callbacks{0};
+    void record_written(const GPIO::EdgeEvent&)
+    {
+        written_at_callback = reflex_backend->written.load();
+        reflex_callbacks++;
+    }
+
+    void Reflex()
+    {
+        reflex_backend = std::make_shared<EventfdBackend>();
+        auto& backend = reflex_backend;
+        auto input = make_channel(24);
+        auto output = make_channel(25);
+
+        assert::are_equal((int)GPIO::EventResultCode::GPIO_Event_Not_Found,
+                          GPIO::_add_reflex(input, GPIO::Edge::RISING, output, 0));
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, input, GPIO::Edge::RISING, 0));
+        assert::are_equal((int)GPIO::EventResultCode::IllegalEdgeArgument,
+                          GPIO::_add_reflex(input, GPIO::Edge::NONE, output, 0));
+
+        // written before the callbacks are called
+        assert::are_equal(0, GPIO::_add_reflex(input, GPIO::Edge::BOTH, output, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(24, GPIO::Callback(record_written)));
+        backend->trigger(24);
+        assert::is_true(wait_for([]() { return written_at_callback == 0; }));
+        assert::are_equal(1, backend->write_count.load());
+
+        // only the matching edges, toggling the value read back
+        GPIO::_clear_reflexes(24);
+        assert::are_equal(0, GPIO::_add_reflex(input, GPIO::Edge::FALLING, output, 1));
+        assert::are_equal(0, GPIO::_add_reflex(input, GPIO::Edge::RISING, output, -1));
+        backend->value = 1;
+        backend->trigger(24);
+        assert::is_true(wait_for([&]() { return backend->write_count == 2; }));
+        assert::are_equal(0, backend->written.load());
+
+        GPIO::ChannelEventStats stats{};
+        for (const auto& channel : GPIO::_event_stats().channels)
+        {
+            if (channel.channel == "24")
+                stats = channel;
+        }
+        assert::are_equal(2ULL, stats.reflexes);
+        assert::are_equal(0ULL, stats.reflex_errors);
+        assert::is_true(stats.p50_reflex_ns <= stats.max_reflex_ns);
+
+        // not written anymore once the output is cleaned up
+        GPIO::_event_cleanup(25);
+        backend->trigger(24);
+        assert::is_true(wait_for([]() { return reflex_callbacks == 3; }));
+        assert::are_equal(2, backend->write_count.load());
+
+        GPIO::_remove_edge_detect(24);
+        reflex_backend = nullptr;
+    }
+
+    void EventBuffer()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(10), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_set_event_buffer(10, 2));
+        auto buffer = GPIO::_event_buffer(10);
+        assert::is_true(buffer != nullptr);
+
+        // every edge is kept until the buffer is full
+        for (int i = 0; i < 3; i++)
+        {
+            backend->trigger(10);
+            assert::is_true(wait_for([&]() { return buffer->size() + buffer->overflows() == (size_t)i + 1; }));
+        }
+
+        GPIO::EdgeEvent events[4]{};
+        assert::are_equal((size_t)2, buffer->pop(events, 4));
+        assert::are_equal((uint64_t)1, events[0].seqno);
+        assert::are_equal((uint64_t)2, events[1].seqno);
+        assert::are_equal(1ULL, buffer->overflows());
+
+        GPIO::_remove_edge_detect(10);
+        assert::is_true(GPIO::_event_buffer(10) == nullptr);
+        assert::are_equal((int)GPIO::EventResultCode::GPIO_Event_Not_Found, GPIO::_set_event_buffer(10, 2));
+    }
+
+    void WaitForEdges()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        std::vector<GPIO::ChannelInfo> ch_infos = {make_channel(11), make_channel(12), make_channel(13)};
+        std::vector<GPIO::EdgeEvent> detected{};
+
+        // one thread waits for all the channels
+        for (const auto& ch_info : ch_infos)
+            backend->edge_fds[ch_info.gpio] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        std::thread trigger(
+            [&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                backend->trigger(12);
+            });
+        int result = GPIO::_blocking_wait_for_edges(backend, ch_infos, GPIO::Edge::RISING, 0, 1000, detected);
+        trigger.join();
+
+        assert::are_equal((int)GPIO::EventResultCode::EdgeDetected, result);
+        assert::are_equal((size_t)1, detected.size());
+        assert::are_equal(std::string("12"), detected[0].channel);
+        assert::is_true(GPIO::Edge::RISING == detected[0].edge);
+        assert::is_true(detected[0].timestamp_ns > 0);
+
+        // the channels are released after the wait
+        for (int gpio = 11; gpio <= 13; gpio++)
+            assert::is_false(GPIO::_edge_event_exists(gpio));
+
+        // timeout
+        result = GPIO::_blocking_wait_for_edges(backend, ch_infos, GPIO::Edge::RISING, 0, 20, detected);
+        assert::are_equal((int)GPIO::EventResultCode::None, result);
+        assert::is_true(detected.empty());
+    }
+
+    void WaitTimeoutIsAccurate()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        std::vector<GPIO::EdgeEvent> detected{};
+
+        for (uint64_t timeout : {2, 30})
+        {
+            int64_t start = GPIO::_monotonic_ns();
+            int result = GPIO::_blocking_wait_for_edges(backend, {make_channel(14)}, GPIO::Edge::RISING, 0, timeout,
+                                                        detected);
+            int64_t elapsed = GPIO::_monotonic_ns() - start;
+
+            assert::are_equal((int)GPIO::EventResultCode::None, result);
+            assert::is_true(elapsed >= (int64_t)timeout * 1000000, "elapsed: " + std::to_string(elapsed));
+            assert::is_true(elapsed < (int64_t)(timeout + 5) * 1000000, "elapsed: " + std::to_string(elapsed));
+        }
+
+        // the waiting thread sleeps instead of waking up every millisecond
+        long before = context_switches();
+        GPIO::_blocking_wait_for_edges(backend, {make_channel(14)}, GPIO::Edge::RISING, 0, 100, detected);
+        long switches = context_switches() - before;
+        assert::is_true(switches < 20, "context switches: " + std::to_string(switches));
+    }
+
+    void WaitWithEventDetection()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        std::vector<GPIO::EdgeEvent> detected{};
+        int result = 0;
+        callback_count = 0;
+        backend->edge_fds[27] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        // the edge detection starts during the wait: the thread doesn't take the edges of the waiting channel
+        std::thread waiter(
+            [&]()
+            {
+                result = GPIO::_blocking_wait_for_edges(backend, {make_channel(27)}, GPIO::Edge::RISING, 0, 1000,
+                                                        detected);
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(27), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(27, GPIO::Callback(count_callback)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(27);
+        waiter.join();
+        assert::are_equal((int)GPIO::EventResultCode::EdgeDetected, result);
+        assert::are_equal((size_t)1, detected.size());
+
+        // the thread adds the channel when the wait ends
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(27);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+
+        // a wait on a channel with event detection: both see the edge
+        waiter = std::thread(
+            [&]()
+            {
+                result = GPIO::_blocking_wait_for_edges(backend, {make_channel(27)}, GPIO::Edge::RISING, 0, 1000,
+                                                        detected);
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(27);
+        waiter.join();
+        assert::are_equal((int)GPIO::EventResultCode::EdgeDetected, result);
+        assert::are_equal((size_t)1, detected.size());
+        assert::is_true(wait_for([]() { return callback_count == 2; }));
+        assert::is_true(GPIO::_edge_event_detected(27));
+
+        // and the thread reads the channel again after the wait
+        backend->trigger(27);
+        assert::is_true(wait_for([]() { return callback_count == 3; }));
+
+        GPIO::_remove_edge_detect(27);
+    }
+
+    void SysfsWaitWithEventDetection()
+    {
+        auto backend = std::make_shared<SysfsLikeBackend>();
+        std::vector<GPIO::EdgeEvent> detected{};
+        callback_count = 0;
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(29), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(29, GPIO::Callback(count_callback)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // the end of a wait is not an edge
+        for (int i = 0; i < 3; i++)
+        {
+            int result = GPIO::_blocking_wait_for_edges(backend, {make_channel(29)}, GPIO::Edge::RISING, 0, 20,
+                                                        detected);
+            assert::are_equal((int)GPIO::EventResultCode::None, result);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        assert::are_equal(0, callback_count.load());
+
+        int result = 0;
+        std::thread waiter(
+            [&]()
+            {
+                result = GPIO::_blocking_wait_for_edges(backend, {make_channel(29)}, GPIO::Edge::RISING, 0, 1000,
+                                                        detected);
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(29);
+        waiter.join();
+        assert::are_equal((int)GPIO::EventResultCode::EdgeDetected, result);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert::are_equal(1, callback_count.load());
+
+        GPIO::_remove_edge_detect(29);
+    }
+
+    void WaitWithGlitchFilter()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        std::vector<GPIO::EdgeEvent> detected{};
+        received_events.clear();
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(30), GPIO::Edge::BOTH, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(30, GPIO::Callback(record_event)));
+        assert::are_equal(0, GPIO::_set_glitch_filter(make_channel(30), 5000000));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        int result = 0;
+        auto wait = [&](uint64_t timeout)
+        {
+            return std::thread(
+                [&, timeout]()
+                {
+                    result = GPIO::_blocking_wait_for_edges(backend, {make_channel(30)}, GPIO::Edge::BOTH, 0, timeout,
+                                                            detected);
+                });
+        };
+
+        // a glitch is not reported by the wait
+        backend->edge_level = 1;
+        backend->value = 0;
+        std::thread waiter = wait(50);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(30);
+        waiter.join();
+        assert::are_equal((int)GPIO::EventResultCode::None, result);
+        assert::are_equal((size_t)0, received_count());
+
+        // the wait reports the edge when it is delivered, as the callbacks see it
+        backend->value = 1;
+        waiter = wait(1000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto start = std::chrono::steady_clock::now();
+        backend->trigger(30);
+        waiter.join();
+        assert::is_true(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5));
+        assert::are_equal((int)GPIO::EventResultCode::EdgeDetected, result);
+        assert::are_equal((size_t)1, detected.size());
+        assert::is_true(wait_for([]() { return received_count() == 1; }));
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+            assert::are_equal(received_events[0].seqno, detected[0].seqno);
+            assert::are_equal(1, detected[0].level);
+        }
+
+        GPIO::_remove_edge_detect(30);
+    }
+
+    void PulseCounter()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_pulse_counter(backend, make_channel(15), GPIO::Edge::RISING));
+        auto counter = GPIO::_pulse_counter(15);
+        assert::is_true(counter != nullptr);
+
+        // the channel only counts
+        assert::are_equal((int)GPIO::EventResultCode::EdgeSinkConflict,
+                          GPIO::_add_edge_callback(15, GPIO::Callback(count_callback)));
+        assert::are_equal((int)GPIO::EventResultCode::EdgeSinkConflict,
+                          GPIO::_add_edge_detect(backend, make_channel(15), GPIO::Edge::RISING, 0));
+
+        for (uint64_t i = 1; i <= 3; i++)
+        {
+            backend->timestamp_ns = i * 1000000;
+            backend->trigger(15);
+            assert::is_true(wait_for([&]() { return counter->read(0).count == i; }));
+        }
+
+        auto count = counter->read(3000000);
+        assert::are_equal((uint64_t)3000000, count.last_edge_ns);
+        assert::is_true(count.frequency_hz > 999.0 && count.frequency_hz < 1001.0);
+        assert::is_false(GPIO::_edge_event_detected(15));
+
+        GPIO::_remove_edge_detect(15);
+        assert::is_true(GPIO::_pulse_counter(15) == nullptr);
+
+        // a channel with event detection can't count
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(16), GPIO::Edge::RISING, 0));
+        assert::are_equal((int)GPIO::EventResultCode::EdgeSinkConflict,
+                          GPIO::_add_pulse_counter(backend, make_channel(16), GPIO::Edge::RISING));
+        GPIO::_remove_edge_detect(16);
+    }
+
+    // the gpios of the edges, in order
+    class RecordingSink : public GPIO::EdgeSink
+    {
+    public:
+        std::vector<int> start_levels{};
+
+        void on_start(const std::vector<int>& levels) override { start_levels = levels; }
+
+        void on_edge(int gpio, GPIO::Edge, int, uint64_t) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _gpios.push_back(gpio);
+        }
+
+        std::vector<int> gpios()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _gpios;
+        }
+
+    private:
+        std::mutex _mutex{};
+        std::vector<int> _gpios{};
+    };
+
+    void EdgeSinks()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        auto sink = std::make_shared<RecordingSink>();
+        assert::are_equal(0, GPIO::_add_edge_sinks(backend, {make_channel(17), make_channel(18)}, GPIO::Edge::BOTH,
+                                                   sink));
+        assert::is_true(sink->start_levels == std::vector<int>{0, 0});
+
+        backend->trigger(18);
+        assert::is_true(wait_for([&]() { return sink->gpios().size() == 1; }));
+        backend->trigger(17);
+        assert::is_true(wait_for([&]() { return sink->gpios().size() == 2; }));
+        assert::is_true(sink->gpios() == std::vector<int>{18, 17});
+
+        // all the channels or none
+        auto other = std::make_shared<RecordingSink>();
+        assert::are_equal((int)GPIO::EventResultCode::EdgeSinkConflict,
+                          GPIO::_add_edge_sinks(backend, {make_channel(19), make_channel(18)}, GPIO::Edge::BOTH,
+                                                other));
+        assert::is_true(other->start_levels.empty());
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(19), GPIO::Edge::RISING, 0));
+        GPIO::_remove_edge_detect(19);
+
+        // removed by the sink it gives the edges to only
+        GPIO::_remove_edge_sink(17, other);
+        GPIO::_remove_edge_sink(18, other);
+        assert::are_equal((int)GPIO::EventResultCode::EdgeSinkConflict,
+                          GPIO::_add_edge_detect(backend, make_channel(17), GPIO::Edge::RISING, 0));
+        GPIO::_remove_edge_sink(17, sink);
+        GPIO::_remove_edge_sink(18, sink);
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(17), GPIO::Edge::RISING, 0));
+        GPIO::_remove_edge_detect(17);
+    }
+
+    void EventFdWhileThreadRuns()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(21), GPIO::Edge::RISING, 0));
+        assert::are_equal((int)GPIO::EventResultCode::EventThreadRunning, GPIO::_event_fd());
+        assert::are_equal((int)GPIO::EventResultCode::EventLoopNotEmbedded, GPIO::_process_events());
+        GPIO::_remove_edge_detect(21);
+    }
+
+    void InitialEdgeIsSkipped()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        backend->initial_event = true;
+        callback_count = 0;
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(23), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(23, GPIO::Callback(count_callback)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // the first edge is the one reported when the detection started, not the next ones
+        backend->trigger(23);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert::are_equal(0, callback_count.load());
+        backend->trigger(23);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+        backend->trigger(23);
+        assert::is_true(wait_for([]() { return callback_count == 2; }));
+
+        GPIO::_remove_edge_detect(23);
+    }
+
+    void GlitchFilter()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        received_events.clear();
+        assert::are_equal((int)GPIO::EventResultCode::GPIO_Event_Not_Found,
+                          GPIO::_set_glitch_filter(make_channel(24), 2000000));
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(24), GPIO::Edge::BOTH, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(24, GPIO::Callback(record_event)));
+        assert::are_equal(0, GPIO::_set_glitch_filter(make_channel(24), 2000000));
+        auto glitches = []()
+        {
+            for (const auto& channel : GPIO::_event_stats().channels)
+            {
+                if (channel.channel == "24")
+                    return channel.glitches;
+            }
+            return 0ULL;
+        };
+
+        // the channel went back to 0 before the end of the window
+        backend->edge_level = 1;
+        backend->trigger(24);
+        assert::is_true(wait_for([&]() { return glitches() == 1; }));
+
+        // held: delivered after the window, with its level
+        backend->value = 1;
+        auto start = std::chrono::steady_clock::now();
+        backend->trigger(24);
+        assert::is_true(wait_for([]() { return received_count() == 1; }));
+        assert::is_true(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(2));
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+            assert::are_equal(1, received_events[0].level);
+            assert::is_true(received_events[0].edge == GPIO::Edge::RISING);
+        }
+
+        // two edges within the window: the first one is dropped, and the second one is back to the same level
+        assert::are_equal(0, GPIO::_set_glitch_filter(make_channel(24), 50000000));
+        backend->edge_level = 0;
+        backend->trigger(24);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        backend->edge_level = 1;
+        backend->trigger(24);
+        assert::is_true(wait_for([&]() { return glitches() == 3; }));
+        assert::are_equal((size_t)1, received_count());
+
+        // without the filter, the edges are delivered at once
+        assert::are_equal(0, GPIO::_set_glitch_filter(make_channel(24), 0));
+        backend->trigger(24);
+        assert::is_true(wait_for([]() { return received_count() == 2; }));
+
+        GPIO::_remove_edge_detect(24);
+    }
+
+    // the bounce time drops an edge before the glitch filter sees it: the held edge is not taken for a glitch
+    void BounceTimeBeforeGlitchFilter()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        received_events.clear();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(26), GPIO::Edge::BOTH, 5));
+        assert::are_equal(0, GPIO::_add_edge_callback(26, GPIO::Callback(record_event)));
+        assert::are_equal(0, GPIO::_set_glitch_filter(make_channel(26), 50000000));
+
+        backend->value = 1;
+        uint64_t first_ns = GPIO::_monotonic_ns();
+        backend->timestamp_ns = first_ns;
+        backend->trigger(26);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        backend->timestamp_ns = first_ns + 1000000;
+        backend->trigger(26);
+
+        assert::is_true(wait_for([]() { return received_count() == 1; }));
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+            assert::are_equal(first_ns, received_events[0].timestamp_ns);
+        }
+
+        GPIO::ChannelEventStats stats{};
+        for (const auto& channel : GPIO::_event_stats().channels)
+        {
+            if (channel.channel == "26")
+                stats = channel;
+        }
+        assert::are_equal(2ULL, stats.edges);
+        assert::are_equal(1ULL, stats.debounced);
+        assert::are_equal(0ULL, stats.glitches);
+
+        backend->timestamp_ns = 0;
+        GPIO::_remove_edge_detect(26);
+    }
+
+    void AddWhileRunning()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        callback_count = 0;
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(1), GPIO::Edge::RISING, 0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // the blocked thread is woken up to add the second channel
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(2), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(2, GPIO::Callback(count_callback)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(2);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+
+        // and to remove it
+        GPIO::_remove_edge_detect(2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert::are_equal(1, callback_count.load());
+
+        GPIO::_remove_edge_detect(1);
+    }
+
+    void ReaddBeforeThreadRuns()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        callback_count = 0;
+
+        // another channel keeps the thread running
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(31), GPIO::Edge::RISING, 0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // added, removed and added again before the thread applies the changes
+        {
+            auto lock = GPIO::_lock_line_requests();
+            assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(32), GPIO::Edge::RISING, 0));
+            GPIO::_remove_edge_detect(32);
+            assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(32), GPIO::Edge::RISING, 0));
+            assert::are_equal(0, GPIO::_add_edge_callback(32, GPIO::Callback(count_callback)));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(32);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+
+        // removed and added again during a wait: added when the wait ends
+        backend->edge_fds[33] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        std::vector<GPIO::EdgeEvent> detected{};
+        std::thread waiter(
+            [&]()
+            {
+                GPIO::_blocking_wait_for_edges(backend, {make_channel(33)}, GPIO::Edge::RISING, 0, 30, detected);
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(33), GPIO::Edge::RISING, 0));
+        GPIO::_remove_edge_detect(33);
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(33), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(33, GPIO::Callback(count_callback)));
+        waiter.join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(33);
+        assert::is_true(wait_for([]() { return callback_count == 2; }));
+
+        GPIO::_remove_edge_detect(33);
+        GPIO::_remove_edge_detect(32);
+        GPIO::_remove_edge_detect(31);
+    }
+
+    void RemoveClosesEdgeFd()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        callback_count = 0;
+
+        // another channel keeps the thread running
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(34), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(35), GPIO::Edge::RISING, 0));
+        const int fd = backend->last_edge_fd;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        {
+            // closed on the removal, before the thread erases the event object: the line isn't kept requested
+            auto lock = GPIO::_lock_line_requests();
+            GPIO::_remove_edge_detect(35);
+            assert::are_equal(-1, fcntl(fd, F_GETFD));
+
+            // and opened again if the channel is added back in the meantime
+            assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(35), GPIO::Edge::RISING, 0));
+            assert::is_true(fcntl(backend->last_edge_fd, F_GETFD) != -1);
+            assert::are_equal(0, GPIO::_add_edge_callback(35, GPIO::Callback(count_callback)));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        backend->trigger(35);
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+
+        GPIO::_remove_edge_detect(35);
+        GPIO::_remove_edge_detect(34);
+    }
+
+    std::atomic_bool slow_callback_running{false};
+    std::atomic_bool release_slow_callback{false};
+    void slow_callback()
+    {
+        slow_callback_running = true;
+        while (!release_slow_callback)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        slow_callback_running = false;
+    }
+
+    void SlowCallbackDoesNotBlockDetection()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        callback_count = 0;
+        release_slow_callback = false;
+
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(4), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(5), GPIO::Edge::RISING, 0));
+        assert::are_equal(0, GPIO::_add_edge_callback(4, GPIO::Callback(slow_callback)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        backend->trigger(4);
+        assert::is_true(wait_for([]() { return slow_callback_running.load(); }));
+
+        // edges are still detected and callbacks can be added while a callback runs
+        assert::are_equal(0, GPIO::_add_edge_callback(5, GPIO::Callback(count_callback)));
+        backend->trigger(5);
+        assert::is_true(wait_for([]() { return GPIO::_edge_event_detected(5); }));
+        assert::are_equal(0, callback_count.load()); // the only worker is busy
+
+        auto stats = GPIO::_callback_stats();
+        assert::are_equal((size_t)1, stats.queued);
+
+        release_slow_callback = true;
+        assert::is_true(wait_for([]() { return callback_count == 1; }));
+
+        // the removal returns once the callback being run has returned
+        release_slow_callback = false;
+        backend->trigger(4);
+        assert::is_true(wait_for([]() { return slow_callback_running.load(); }));
+        std::thread release(
+            []()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                release_slow_callback = true;
+            });
+        GPIO::_remove_edge_detect(4);
+        assert::is_false(slow_callback_running.load());
+        release.join();
+
+        GPIO::_remove_edge_detect(5);
+    }
+
+    void IdleThreadSleeps()
+    {
+        auto backend = std::make_shared<EventfdBackend>();
+        assert::are_equal(0, GPIO::_add_edge_detect(backend, make_channel(3), GPIO::Edge::RISING, 0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // a thread polling every millisecond would switch about 100 times
+        long before = context_switches();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        long switches = context_switches() - before;
+        assert::is_true(switches < 20, "context switches: " + std::to_string(switches));
+
+        GPIO::_remove_edge_detect(3);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(CallbackIsCalled));
+    suit.add(TEST(EdgeEventRecord));
+    suit.add(TEST(BounceTimeUsesTimestamps));
+    suit.add(TEST(EventBuffer));
+    suit.add(TEST(WaitForEdges));
+    suit.add(TEST(WaitTimeoutIsAccurate));
+    suit.add(TEST(WaitWithEventDetection));
+    suit.add(TEST(SysfsWaitWithEventDetection));
+    suit.add(TEST(WaitWithGlitchFilter));
+    suit.add(TEST(PulseCounter));
+    suit.add(TEST(EdgeSinks));
+    suit.add(TEST(EventFdWhileThreadRuns));
+    suit.add(TEST(InitialEdgeIsSkipped));
+    suit.add(TEST(KernelDebounce));
+    suit.add(TEST(Reflex));
+    suit.add(TEST(GlitchFilter));
+    suit.add(TEST(BounceTimeBeforeGlitchFilter));
+    suit.add(TEST(AddWhileRunning));
+    suit.add(TEST(ReaddBeforeThreadRuns));
+    suit.add(TEST(RemoveClosesEdgeFd));
+    suit.add(TEST(SlowCallbackDoesNotBlockDetection));
+    suit.add(TEST(IdleThreadSleeps));
+#undef TEST
+
+    return suit.run();
+}
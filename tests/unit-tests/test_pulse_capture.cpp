@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+#include "private/PulseCaptureSink.h"
+#include "private/TestUtility.h"
+
+namespace
+{
+    constexpr uint64_t us = 1000;
+
+    void WidthAndPeriod()
+    {
+        GPIO::PulseCaptureSink sink(8);
+
+        // the first edge is falling: not a pulse
+        sink.on_edge(1, GPIO::Edge::FALLING, 0, 50 * us);
+
+        // 1.0 ms, 1.5 ms and 2.0 ms pulses every 20 ms
+        uint64_t widths[] = {1000 * us, 1500 * us, 2000 * us};
+        for (int i = 0; i < 3; i++)
+        {
+            uint64_t rise = 100 * us + i * 20000 * us;
+            sink.on_edge(1, GPIO::Edge::RISING, 1, rise);
+            sink.on_edge(1, GPIO::Edge::FALLING, 0, rise + widths[i]);
+        }
+
+        GPIO::PulseMeasurement measurements[8]{};
+        assert::are_equal((size_t)3, sink.read(measurements, 8));
+        assert::are_equal(100 * us, measurements[0].rise_ns);
+        assert::are_equal(1000 * us, measurements[0].width_ns);
+        assert::are_equal((uint64_t)0, measurements[0].period_ns);
+        assert::are_equal(2000 * us, measurements[2].width_ns);
+        assert::are_equal(20000 * us, measurements[2].period_ns);
+        assert::are_equal((size_t)0, sink.read(measurements, 8));
+
+        auto stats = sink.stats();
+        assert::are_equal(3ULL, stats.pulses);
+        assert::are_equal(1000 * us, stats.min_width_ns);
+        assert::are_equal(2000 * us, stats.max_width_ns);
+        assert::are_equal(1500.0 * us, stats.mean_width_ns);
+        assert::are_equal(2ULL, stats.periods);
+        assert::are_equal(20000 * us, stats.min_period_ns);
+        assert::are_equal(20000.0 * us, stats.mean_period_ns);
+    }
+
+    void MissingFallingEdge()
+    {
+        GPIO::PulseCaptureSink sink(8);
+
+        // two rising edges in a row: a period but no pulse
+        sink.on_edge(1, GPIO::Edge::RISING, 1, 1000 * us);
+        sink.on_edge(1, GPIO::Edge::RISING, 1, 3000 * us);
+        sink.on_edge(1, GPIO::Edge::FALLING, 0, 3500 * us);
+        sink.on_edge(1, GPIO::Edge::FALLING, 0, 3600 * us);
+
+        GPIO::PulseMeasurement measurements[8]{};
+        assert::are_equal((size_t)1, sink.read(measurements, 8));
+        assert::are_equal(500 * us, measurements[0].width_ns);
+        assert::are_equal(2000 * us, measurements[0].period_ns);
+        assert::are_equal(1ULL, sink.stats().pulses);
+    }
+
+    void Overflow()
+    {
+        GPIO::PulseCaptureSink sink(2);
+        for (uint64_t i = 1; i <= 5; i++)
+        {
+            sink.on_edge(1, GPIO::Edge::RISING, 1, i * 1000 * us);
+            sink.on_edge(1, GPIO::Edge::FALLING, 0, i * 1000 * us + 100 * us);
+        }
+
+        // the statistics include the pulses that didn't fit
+        auto stats = sink.stats();
+        assert::are_equal(5ULL, stats.pulses);
+        assert::are_equal(3ULL, stats.overflows);
+
+        GPIO::PulseMeasurement measurements[8]{};
+        assert::are_equal((size_t)2, sink.read(measurements, 8));
+        assert::are_equal(1000 * us, measurements[0].rise_ns);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(WidthAndPeriod));
+    suit.add(TEST(MissingFallingEdge));
+    suit.add(TEST(Overflow));
+#undef TEST
+
+    return suit.run();
+}
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+#include "private/PulseCounter.h"
+#include "private/TestUtility.h"
+
+#include <cmath>
+
+namespace
+{
+    constexpr uint64_t ms = 1000000;
+
+    bool near(double expected, double actual) { return std::fabs(expected - actual) < expected * 1e-6; }
+
+    void Empty()
+    {
+        GPIO::PulseCounter counter;
+        auto count = counter.read(10 * ms);
+        assert::are_equal(0ULL, count.count);
+        assert::are_equal((uint64_t)0, count.last_edge_ns);
+        assert::are_equal(0.0, count.frequency_hz);
+
+        // one edge has no interval yet
+        counter.add(5 * ms);
+        count = counter.read(6 * ms);
+        assert::are_equal(1ULL, count.count);
+        assert::are_equal(5 * ms, count.last_edge_ns);
+        assert::are_equal(0.0, count.average_frequency_hz);
+    }
+
+    void SteadyRate()
+    {
+        // 100 Hz
+        GPIO::PulseCounter counter;
+        for (uint64_t i = 1; i <= 50; i++)
+            counter.add(i * 10 * ms);
+
+        auto count = counter.read(500 * ms);
+        assert::are_equal(50ULL, count.count);
+        assert::is_true(near(100.0, count.frequency_hz));
+        assert::is_true(near(100.0, count.average_frequency_hz));
+    }
+
+    void RateChange()
+    {
+        GPIO::PulseCounter counter;
+        uint64_t t = 0;
+        for (int i = 0; i < 20; i++)
+            counter.add(t += 10 * ms);
+
+        // 10 ms -> 5 ms: the last interval changes at once, the average moves by 1/8 of the difference
+        counter.add(t += 5 * ms);
+        auto count = counter.read(t);
+        assert::is_true(near(200.0, count.frequency_hz));
+        double average_interval = 10 * ms - (10 * ms >> GPIO::PulseCounter::average_shift) +
+                                  (5 * ms >> GPIO::PulseCounter::average_shift);
+        assert::is_true(near(1e9 / average_interval, count.average_frequency_hz));
+
+        for (int i = 0; i < 100; i++)
+            counter.add(t += 5 * ms);
+        assert::is_true(std::fabs(200.0 - counter.read(t).average_frequency_hz) < 0.1);
+    }
+
+    void Stopped()
+    {
+        GPIO::PulseCounter counter;
+        for (uint64_t i = 1; i <= 10; i++)
+            counter.add(i * 10 * ms);
+
+        // 1 s without an edge: at most 1 Hz
+        auto count = counter.read(1100 * ms);
+        assert::is_true(near(1.0, count.frequency_hz));
+        assert::is_true(near(1.0, count.average_frequency_hz));
+        assert::are_equal(10ULL, count.count);
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(Empty));
+    suit.add(TEST(SteadyRate));
+    suit.add(TEST(RateChange));
+    suit.add(TEST(Stopped));
+#undef TEST
+
+    return suit.run();
+}
@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/QuadratureDecoder.h"
+#include "private/TestUtility.h"
+
+namespace
+{
+    constexpr int A = 10;
+    constexpr int B = 20;
+
+    // one cycle with A leading B, from A = B = 0
+    void forward_cycle(GPIO::QuadratureDecoder& decoder)
+    {
+        decoder.on_edge(A, GPIO::Edge::RISING, 1, 0);
+        decoder.on_edge(B, GPIO::Edge::RISING, 1, 0);
+        decoder.on_edge(A, GPIO::Edge::FALLING, 0, 0);
+        decoder.on_edge(B, GPIO::Edge::FALLING, 0, 0);
+    }
+
+    void Forward()
+    {
+        GPIO::QuadratureDecoder decoder(A, B);
+        decoder.on_start({0, 0});
+        assert::are_equal(0, decoder.direction());
+
+        forward_cycle(decoder);
+        forward_cycle(decoder);
+        assert::are_equal((int64_t)8, decoder.position());
+        assert::are_equal(1, decoder.direction());
+        assert::are_equal(0ULL, decoder.errors());
+    }
+
+    void Backward()
+    {
+        GPIO::QuadratureDecoder decoder(A, B);
+        decoder.on_start({1, 1});
+
+        // B leads A, from A = B = 1
+        decoder.on_edge(B, GPIO::Edge::FALLING, 0, 0);
+        decoder.on_edge(A, GPIO::Edge::FALLING, 0, 0);
+        decoder.on_edge(B, GPIO::Edge::RISING, 1, 0);
+        assert::are_equal((int64_t)-3, decoder.position());
+        assert::are_equal(-1, decoder.direction());
+
+        // back one step
+        decoder.on_edge(B, GPIO::Edge::FALLING, 0, 0);
+        assert::are_equal((int64_t)-2, decoder.position());
+        assert::are_equal(1, decoder.direction());
+        assert::are_equal(0ULL, decoder.errors());
+    }
+
+    void IllegalTransition()
+    {
+        GPIO::QuadratureDecoder decoder(A, B);
+        decoder.on_start({0, 0});
+        decoder.on_edge(A, GPIO::Edge::RISING, 1, 0);
+
+        // the falling edge of B was missed: 11 -> 01 -> 00 seen as 10 -> 00 -> 00
+        decoder.on_edge(A, GPIO::Edge::FALLING, 0, 0);
+        decoder.on_edge(B, GPIO::Edge::FALLING, 0, 0);
+        assert::are_equal(1ULL, decoder.errors());
+        assert::are_equal((int64_t)0, decoder.position());
+
+        // decoding goes on from the levels after the error
+        decoder.on_edge(A, GPIO::Edge::RISING, 1, 0);
+        assert::are_equal((int64_t)1, decoder.position());
+        assert::are_equal(1ULL, decoder.errors());
+    }
+
+    void UnknownLevel()
+    {
+        GPIO::QuadratureDecoder decoder(A, B);
+        decoder.on_start({0, 0});
+
+        // the edge gives the level, or toggles it if it is unknown too
+        decoder.on_edge(A, GPIO::Edge::RISING, -1, 0);
+        decoder.on_edge(B, GPIO::Edge::UNKNOWN, -1, 0);
+        decoder.on_edge(A, GPIO::Edge::UNKNOWN, -1, 0);
+        decoder.on_edge(B, GPIO::Edge::FALLING, -1, 0);
+        assert::are_equal((int64_t)4, decoder.position());
+        assert::are_equal(0ULL, decoder.errors());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(Forward));
+    suit.add(TEST(Backward));
+    suit.add(TEST(IllegalTransition));
+    suit.add(TEST(UnknownLevel));
+#undef TEST
+
+    return suit.run();
+}
@@ -0,0 +1,249 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include "private/SoftPWMScheduler.h"
+#include "private/TestUtility.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Records the values written to the lines. Nothing else is used by the scheduler.
+    class RecordingBackend : public GPIO::Backend
+    {
+    public:
+        GPIO::Backends type() const override { return GPIO::Backends::CDEV; }
+        void check_permission(const GPIO::ChannelTable&) const override {}
+        GPIO::Directions direction(const GPIO::ChannelInfo&) override { return GPIO::Directions::OUT; }
+        void setup_out(const GPIO::ChannelInfo&, int) override {}
+        void setup_in(const GPIO::ChannelInfo&) override {}
+        void release(const GPIO::ChannelInfo&) override {}
+        void write(const GPIO::ChannelInfo&, int) override {}
+        int read(const GPIO::ChannelInfo&) override { return 0; }
+        void group(const std::vector<GPIO::ChannelInfo>&) override {}
+        uint64_t read_lines(const GPIO::LineRequest&, uint64_t) override { return 0; }
+        int open_edge(const GPIO::ChannelInfo&, GPIO::Edge, int&) override { return 0; }
+        int set_edge(const GPIO::ChannelInfo&, GPIO::Edge) override { return 0; }
+        bool set_debounce(const GPIO::ChannelInfo&, uint64_t) override { return false; }
+        size_t read_edges(int, GPIO::EdgeRecord*, size_t) override { return 0; }
+        bool initial_edge_event() const override { return false; }
+
+        void write_lines(const GPIO::LineRequest& request, uint64_t mask, uint64_t bits) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writes.emplace_back(mask, bits);
+            last_request = &request;
+        }
+
+        const GPIO::LineRequest* get_last_request()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return last_request;
+        }
+
+        std::vector<std::pair<uint64_t, uint64_t>> get_writes()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return writes;
+        }
+
+    private:
+        std::mutex mutex{};
+        std::vector<std::pair<uint64_t, uint64_t>> writes{};
+        const GPIO::LineRequest* last_request = nullptr;
+    };
+
+    GPIO::ChannelInfo make_channel(int id, unsigned index, std::shared_ptr<GPIO::LineRequest> request)
+    {
+        GPIO::ChannelInfo ch_info{id, std::to_string(id), "/sys/devices/gpio", "/dev/gpiochip0", int(index),
+                                  300 + int(index), "gpio" + std::to_string(300 + index), "None", -1};
+        ch_info.line->request = std::move(request);
+        ch_info.line->index = index;
+        return ch_info;
+    }
+
+    void sleep_ms(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+    void Toggles()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto ch_info = make_channel(0, 3, std::make_shared<GPIO::LineRequest>());
+        GPIO::SoftPWMScheduler scheduler;
+
+        // 500 Hz, 25 %
+        auto handle = scheduler.add(backend, ch_info, 2000000, 500000);
+        sleep_ms(100);
+        auto stats = scheduler.stats(handle);
+        assert::is_true(scheduler.remove(handle));
+        assert::is_false(scheduler.running(handle));
+
+        auto writes = backend->get_writes();
+        assert::is_true(writes.size() > 10);
+        // edges may be written between stats() and remove()
+        assert::is_true(stats.edges > 0 && stats.edges < writes.size());
+        for (size_t i = 0; i < writes.size(); i++)
+        {
+            assert::are_equal(uint64_t(1) << 3, writes[i].first);
+            // HIGH, LOW, HIGH, ... and LOW when removed
+            uint64_t expected = (i % 2 == 0 && i + 1 != writes.size()) ? (uint64_t(1) << 3) : 0;
+            assert::are_equal(expected, writes[i].second);
+        }
+
+        // nothing is written after remove()
+        sleep_ms(10);
+        assert::are_equal(writes.size(), backend->get_writes().size());
+        assert::is_false(scheduler.remove(handle));
+    }
+
+    void RequestReplaced()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto first = std::make_shared<GPIO::LineRequest>();
+        auto ch_info = make_channel(0, 2, first);
+        GPIO::SoftPWMScheduler scheduler;
+
+        // the scheduler doesn't keep the request: the backend can release it, e.g. to merge the line with others
+        auto handle = scheduler.add(backend, ch_info, 1000000, 500000);
+        sleep_ms(10);
+        assert::is_true(backend->get_last_request() == first.get());
+        assert::are_equal(2L, (long)first.use_count()); // first and ch_info.line
+
+        auto second = std::make_shared<GPIO::LineRequest>();
+        {
+            auto lock = scheduler.lock_lines();
+            ch_info.line->request = second;
+            ch_info.line->index = 5;
+        }
+        sleep_ms(10);
+        assert::is_true(backend->get_last_request() == second.get());
+        assert::are_equal(uint64_t(1) << 5, backend->get_writes().back().first);
+
+        // a released line stops the SoftPWM
+        {
+            auto lock = scheduler.lock_lines();
+            ch_info.line->request = nullptr;
+        }
+        sleep_ms(10);
+        assert::is_false(scheduler.running(handle));
+    }
+
+    void ConstantLevels()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto ch_info = make_channel(0, 0, std::make_shared<GPIO::LineRequest>());
+        GPIO::SoftPWMScheduler scheduler;
+
+        // 0 %: LOW once
+        auto handle = scheduler.add(backend, ch_info, 1000000, 0);
+        sleep_ms(20);
+        auto writes = backend->get_writes();
+        assert::are_equal((size_t)1, writes.size());
+        assert::are_equal(uint64_t(0), writes[0].second);
+
+        // 100 %: HIGH once. high_ns is clamped to the period.
+        scheduler.update(handle, 1000000, 2000000);
+        sleep_ms(20);
+        writes = backend->get_writes();
+        assert::are_equal((size_t)2, writes.size());
+        assert::are_equal(uint64_t(1), writes[1].second);
+
+        // back to switching
+        scheduler.update(handle, 1000000, 500000);
+        sleep_ms(20);
+        assert::is_true(backend->get_writes().size() > 4);
+        scheduler.remove(handle);
+    }
+
+    void OneChannelPerSoftPWM()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto ch_info = make_channel(0, 0, std::make_shared<GPIO::LineRequest>());
+        GPIO::SoftPWMScheduler scheduler;
+
+        auto handle = scheduler.add(backend, ch_info, 1000000, 0);
+        assert::expect_exception([&]() { scheduler.add(backend, ch_info, 1000000, 0); });
+
+        // a free slot is reused with a new generation
+        scheduler.remove(handle);
+        auto other = scheduler.add(backend, ch_info, 1000000, 0);
+        assert::are_equal(handle.slot, other.slot);
+        assert::is_false(scheduler.running(handle));
+        assert::is_true(scheduler.running(other));
+        scheduler.remove(other);
+    }
+
+    void ChannelNotSetUp()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto ch_info = make_channel(0, 0, nullptr);
+        GPIO::SoftPWMScheduler scheduler;
+
+        assert::expect_exception([&]() { scheduler.add(backend, ch_info, 1000000, 0); });
+        assert::expect_exception([&]() { scheduler.add(backend, ch_info, 0, 0); });
+    }
+
+    void RemoveChannel()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto request = std::make_shared<GPIO::LineRequest>();
+        auto ch_a = make_channel(0, 0, request);
+        auto ch_b = make_channel(1, 1, request);
+        GPIO::SoftPWMScheduler scheduler;
+
+        auto a = scheduler.add(backend, ch_a, 1000000, 500000);
+        auto b = scheduler.add(backend, ch_b, 1000000, 500000);
+        sleep_ms(10);
+
+        // cleanup() releases the line right after, so nothing is written
+        scheduler.remove_channel(0);
+        assert::is_false(scheduler.running(a));
+        assert::is_true(scheduler.running(b));
+
+        scheduler.remove(b);
+        auto count = backend->get_writes().size();
+        sleep_ms(10);
+        assert::are_equal(count, backend->get_writes().size());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(Toggles));
+    suit.add(TEST(ConstantLevels));
+    suit.add(TEST(RequestReplaced));
+    suit.add(TEST(OneChannelPerSoftPWM));
+    suit.add(TEST(ChannelNotSetUp));
+    suit.add(TEST(RemoveChannel));
+#undef TEST
+
+    return suit.run();
+}
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2019-2023, Jueon Park(pjueon) <bluegbgb@gmail.com>.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include "private/FileDescriptor.h"
+
+#include "private/GPIOEvent.h"
+#include "private/TestUtility.h"
+#include "private/WaveformPlayback.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    // Records the writes to the lines. Nothing else is used by the playback.
+    class RecordingBackend : public GPIO::Backend
+    {
+    public:
+        using Write = std::tuple<const GPIO::LineRequest*, uint64_t, uint64_t>; // request, mask, bits
+
+        GPIO::Backends type() const override { return GPIO::Backends::CDEV; }
+        void check_permission(const GPIO::ChannelTable&) const override {}
+        GPIO::Directions direction(const GPIO::ChannelInfo&) override { return GPIO::Directions::OUT; }
+        void setup_out(const GPIO::ChannelInfo&, int) override {}
+        void setup_in(const GPIO::ChannelInfo&) override {}
+        void release(const GPIO::ChannelInfo&) override {}
+        void write(const GPIO::ChannelInfo&, int) override {}
+        int read(const GPIO::ChannelInfo&) override { return 0; }
+        void group(const std::vector<GPIO::ChannelInfo>&) override {}
+        uint64_t read_lines(const GPIO::LineRequest&, uint64_t) override { return 0; }
+        int open_edge(const GPIO::ChannelInfo&, GPIO::Edge, int&) override { return 0; }
+        int set_edge(const GPIO::ChannelInfo&, GPIO::Edge) override { return 0; }
+        bool set_debounce(const GPIO::ChannelInfo&, uint64_t) override { return false; }
+        size_t read_edges(int, GPIO::EdgeRecord*, size_t) override { return 0; }
+        bool initial_edge_event() const override { return false; }
+
+        void write_lines(const GPIO::LineRequest& request, uint64_t mask, uint64_t bits) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writes.emplace_back(&request, mask, bits);
+        }
+
+        std::vector<Write> take_writes()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<Write> taken{};
+            taken.swap(writes);
+            return taken;
+        }
+
+    private:
+        std::mutex mutex{};
+        std::vector<Write> writes{};
+    };
+
+    GPIO::ChannelInfo make_channel(int id, unsigned index, std::shared_ptr<GPIO::LineRequest> request)
+    {
+        GPIO::ChannelInfo ch_info{id, std::to_string(id), "/sys/devices/gpio", "/dev/gpiochip0", int(index),
+                                  300 + int(index), "gpio" + std::to_string(300 + index), "None", -1};
+        ch_info.line->request = std::move(request);
+        ch_info.line->index = index;
+        return ch_info;
+    }
+
+    void sleep_ms(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+    // both channels HIGH, then LOW, every 2 ms
+    const std::vector<GPIO::WaveformStep> square = {{0, 0b11, 0b11}, {1000000, 0b11, 0}};
+
+    void InvalidSteps()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        GPIO::WaveformPlayback playback(backend, {make_channel(0, 0, std::make_shared<GPIO::LineRequest>())});
+
+        assert::expect_exception([&]() { playback.start({}, 0); });
+        assert::expect_exception([&]() { playback.start({{10, 1, 1}, {5, 1, 0}}, 0); });
+        assert::expect_exception([&]() { playback.start({{0, 0b10, 0}}, 0); });
+        assert::is_false(playback.playing());
+    }
+
+    void PlaysOnce()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto request = std::make_shared<GPIO::LineRequest>();
+        GPIO::WaveformPlayback playback(backend, {make_channel(0, 1, request), make_channel(1, 4, request)});
+
+        // the channels of one request are written together
+        playback.start(square, 0);
+        assert::are_equal(std::string(), playback.wait());
+        auto writes = backend->take_writes();
+        assert::are_equal((size_t)2, writes.size());
+        assert::is_true(std::get<0>(writes[0]) == request.get());
+        assert::are_equal(uint64_t(0b10010), std::get<1>(writes[0]));
+        assert::are_equal(uint64_t(0b10010), std::get<2>(writes[0]));
+        assert::are_equal(uint64_t(0), std::get<2>(writes[1]));
+        assert::are_equal(2ULL, playback.stats().steps);
+    }
+
+    void RequestsMerged()
+    {
+        auto backend = std::make_shared<RecordingBackend>();
+        auto first = std::make_shared<GPIO::LineRequest>();
+        auto second = std::make_shared<GPIO::LineRequest>();
+        std::vector<GPIO::ChannelInfo> ch_infos = {make_channel(0, 0, first), make_channel(1, 0, second)};
+        GPIO::WaveformPlayback playback(backend, ch_infos);
+
+        playback.start(square, 2000000);
+        sleep_ms(10);
+        auto writes = backend->take_writes();
+        assert::is_true(writes.size() >= 4);
+        for (const auto& write : writes)
+        {
+            assert::is_true(std::get<0>(write) == first.get() || std::get<0>(write) == second.get());
+            assert::are_equal(uint64_t(1), std::get<1>(write));
+        }
+
+        // the backend merges the lines into one request (e.g. for a PinGroup) during the playback
+        std::weak_ptr<GPIO::LineRequest> released = first;
+        auto merged = std::make_shared<GPIO::LineRequest>();
+        {
+            auto lock = GPIO::_lock_line_requests();
+            ch_infos[0].line->request = merged;
+            ch_infos[0].line->index = 2;
+            ch_infos[1].line->request = merged;
+            ch_infos[1].line->index = 5;
+        }
+        first = nullptr;
+        second = nullptr;
+
+        // the playback doesn't keep the old requests, and writes the new one at once
+        assert::is_true(released.expired());
+        sleep_ms(10);
+        backend->take_writes();
+        sleep_ms(10);
+        writes = backend->take_writes();
+        assert::is_true(writes.size() >= 4);
+        for (const auto& write : writes)
+        {
+            assert::is_true(std::get<0>(write) == merged.get());
+            assert::are_equal(uint64_t(0b100100), std::get<1>(write));
+        }
+        assert::is_true(playback.playing());
+
+        // a released line stops the playback
+        {
+            auto lock = GPIO::_lock_line_requests();
+            ch_infos[1].line->request = nullptr;
+        }
+        std::string failure = playback.wait();
+        assert::is_true(failure.find("cleaned up") != std::string::npos, failure);
+        assert::is_false(playback.playing());
+    }
+} // namespace
+
+int main()
+{
+    TestSuit suit{};
+
+#define TEST(NAME) {#NAME, NAME}
+    suit.add(TEST(InvalidSteps));
+    suit.add(TEST(PlaysOnce));
+    suit.add(TEST(RequestsMerged));
+#undef TEST
+
+    return suit.run();
+}